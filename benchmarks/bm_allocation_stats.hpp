@@ -0,0 +1,18 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include "containers/stats_pmr.hpp"
+
+// Publishes the counters of a stats_pmr as Google Benchmark user counters
+// Counts are averaged over the iterations, byte totals are reported as is
+inline void publish_allocation_stats(benchmark::State& state, ml::allocation_stats const& stats) {
+    auto const avg{benchmark::Counter::kAvgIterations};
+
+    state.counters["allocs"] = benchmark::Counter(static_cast<double>(stats.n_allocations), avg);
+    state.counters["deallocs"] = benchmark::Counter(static_cast<double>(stats.n_deallocations), avg);
+    state.counters["extends"] = benchmark::Counter(static_cast<double>(stats.n_extends), avg);
+    state.counters["extend_hit_rate"] = stats.extend_hit_rate();
+    state.counters["peak_bytes"] = static_cast<double>(stats.peak_bytes);
+    state.counters["padding_bytes"] = benchmark::Counter(static_cast<double>(stats.padding_bytes), avg);
+}
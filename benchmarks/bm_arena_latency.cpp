@@ -0,0 +1,68 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "containers/arena_mmr.hpp"
+
+#include "compiler_pragmas.hpp"
+
+static constexpr std::size_t initial_pool_size{64 * 1024};
+static constexpr std::size_t alloc_bytes{256};
+static constexpr int n_requests{1 << 18};
+// Allocations between the idle points where explicit preparation happens
+static constexpr int n_requests_per_batch{1024};
+
+// Times each allocation plus its first write, which is where a fresh pool's page faults land
+// Reports latency percentiles in nanoseconds over every request of every iteration
+template <typename BetweenBatches>
+static void run_latency(benchmark::State& state, ml::arena_growth_policy const& policy, BetweenBatches between) {
+    using clock = std::chrono::steady_clock;
+
+    std::vector<double> samples;
+    samples.reserve(static_cast<std::size_t>(state.max_iterations) * n_requests);
+    for (auto _ : state) {
+        ml::arena_mmr resource{initial_pool_size, policy};
+        for (int i{0}; i < n_requests; ++i) {
+            if (i % n_requests_per_batch == 0) {
+                between(resource);
+            }
+            auto const start{clock::now()};
+            auto* ptr{static_cast<std::byte*>(resource.allocate(alloc_bytes, alignof(std::max_align_t)))};
+            *ptr = std::byte{1};
+            auto const end{clock::now()};
+            samples.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+        }
+    }
+
+    std::sort(samples.begin(), samples.end());
+    auto const percentile{[&samples](double p) {
+        return samples[static_cast<std::size_t>(p * static_cast<double>(samples.size() - 1))];
+    }};
+    state.SetItemsProcessed(state.iterations() * n_requests);
+    state.counters["p50_ns"] = percentile(0.5);
+    state.counters["p99_ns"] = percentile(0.99);
+    state.counters["p99.9_ns"] = percentile(0.999);
+    state.counters["p99.99_ns"] = percentile(0.9999);
+    state.counters["max_ns"] = samples.back();
+}
+
+static constexpr ml::arena_growth_policy geometric{.curve = ml::arena_growth_curve::geometric};
+
+static void BM_arena_latency_on_demand(benchmark::State& state) {
+    run_latency(state, geometric, [](ml::arena_mmr&) {});
+}
+static void BM_arena_latency_prepare_explicit(benchmark::State& state) {
+    run_latency(state, geometric, [](ml::arena_mmr& resource) { resource.prepare_next_pool(); });
+}
+static void BM_arena_latency_prepare_high_water(benchmark::State& state) {
+    auto policy{geometric};
+    policy.prepare_high_water = 0.5;
+    run_latency(state, policy, [](ml::arena_mmr&) {});
+}
+
+BENCHMARK(BM_arena_latency_on_demand)->Iterations(20);
+BENCHMARK(BM_arena_latency_prepare_explicit)->Iterations(20);
+BENCHMARK(BM_arena_latency_prepare_high_water)->Iterations(20);
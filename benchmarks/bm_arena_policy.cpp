@@ -0,0 +1,78 @@
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "containers/arena_mmr.hpp"
+
+#include "compiler_pragmas.hpp"
+
+static constexpr std::size_t initial_pool_size{16 * 1024};
+static constexpr int n_requests{10'000};
+
+// Mostly small requests with an occasional large one, roughly 1 in 50
+static auto mixed_request_sizes() -> std::vector<std::size_t> const& {
+    static auto const sizes{[] {
+        std::mt19937 rng{42};
+        std::uniform_int_distribution<std::size_t> small{8, 256};
+        std::uniform_int_distribution<std::size_t> large{8 * 1024, 64 * 1024};
+        std::uniform_int_distribution<int> pick{0, 49};
+        std::vector<std::size_t> out(n_requests);
+        for (auto& size : out) {
+            size = pick(rng) == 0 ? large(rng) : small(rng);
+        }
+        return out;
+    }()};
+    return sizes;
+}
+
+// Reports throughput and the share of pool capacity left unused at the end of each pass
+static void run_mixed_stream(benchmark::State& state, ml::arena_growth_policy const& policy) {
+    auto const& sizes{mixed_request_sizes()};
+    std::size_t bytes_requested{0};
+    for (auto const size : sizes) {
+        bytes_requested += size;
+    }
+
+    double waste{0.0};
+    double n_pools{0.0};
+    for (auto _ : state) {
+        ml::arena_mmr resource{initial_pool_size, policy};
+        for (auto const size : sizes) {
+            benchmark::DoNotOptimize(resource.allocate(size, alignof(std::max_align_t)));
+        }
+        waste = 1.0 - static_cast<double>(bytes_requested) / static_cast<double>(resource.total_capacity());
+        n_pools = static_cast<double>(resource.n_pools());
+    }
+    state.SetItemsProcessed(state.iterations() * n_requests);
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(bytes_requested));
+    state.counters["waste"] = waste;
+    state.counters["n_pools"] = n_pools;
+}
+
+static void BM_arena_policy_fixed(benchmark::State& state) {
+    run_mixed_stream(state, {});
+}
+static void BM_arena_policy_geometric(benchmark::State& state) {
+    run_mixed_stream(state, {.curve = ml::arena_growth_curve::geometric});
+}
+static void BM_arena_policy_capped(benchmark::State& state) {
+    run_mixed_stream(state, {.curve = ml::arena_growth_curve::geometric, .max_pool_size = 256 * 1024});
+}
+static void BM_arena_policy_fixed_dedicated(benchmark::State& state) {
+    run_mixed_stream(state, {.dedicated_threshold = 4 * 1024});
+}
+static void BM_arena_policy_capped_dedicated(benchmark::State& state) {
+    run_mixed_stream(state,
+                     {.curve = ml::arena_growth_curve::geometric,
+                      .max_pool_size = 256 * 1024,
+                      .dedicated_threshold = 4 * 1024});
+}
+
+BENCHMARK(BM_arena_policy_fixed);
+BENCHMARK(BM_arena_policy_geometric);
+BENCHMARK(BM_arena_policy_capped);
+BENCHMARK(BM_arena_policy_fixed_dedicated);
+BENCHMARK(BM_arena_policy_capped_dedicated);
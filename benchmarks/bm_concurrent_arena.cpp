@@ -0,0 +1,56 @@
+#include <memory>
+#include <memory_resource>
+
+#include <benchmark/benchmark.h>
+
+#include "containers/arena_pmr.hpp"
+#include "containers/concurrent_arena_pmr.hpp"
+
+#include "compiler_pragmas.hpp"
+
+// The arenas never free so the iteration count is fixed to bound their memory use
+static constexpr int n_iterations{20'000};
+static constexpr int n_allocs{16};
+static constexpr std::size_t alloc_bytes{32};
+static constexpr std::size_t arena_initial_capacity{1 << 16};
+
+// Shared resources are created by thread 0 so they are only read once the loop's start barrier has passed
+template <typename Resource>
+static void allocate_batch(benchmark::State& state, Resource const& resource) {
+    for (auto _ : state) {
+        for (int i{0}; i < n_allocs; ++i) {
+            benchmark::DoNotOptimize(resource->allocate(alloc_bytes, alignof(std::max_align_t)));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * n_allocs);
+}
+
+static std::unique_ptr<ml::concurrent_arena_pmr> shared_arena;
+static std::unique_ptr<std::pmr::synchronized_pool_resource> shared_pool;
+
+static void BM_concurrent_arena_shared(benchmark::State& state) {
+    if (state.thread_index() == 0) {
+        shared_arena = std::make_unique<ml::concurrent_arena_pmr>(arena_initial_capacity);
+    }
+    allocate_batch(state, shared_arena);
+    if (state.thread_index() == 0) {
+        shared_arena.reset();
+    }
+}
+static void BM_concurrent_arena_per_thread(benchmark::State& state) {
+    ml::arena_pmr resource{arena_initial_capacity};
+    allocate_batch(state, &resource);
+}
+static void BM_concurrent_arena_synchronized_pool(benchmark::State& state) {
+    if (state.thread_index() == 0) {
+        shared_pool = std::make_unique<std::pmr::synchronized_pool_resource>();
+    }
+    allocate_batch(state, shared_pool);
+    if (state.thread_index() == 0) {
+        shared_pool.reset();
+    }
+}
+
+BENCHMARK(BM_concurrent_arena_shared)->Iterations(n_iterations)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_concurrent_arena_per_thread)->Iterations(n_iterations)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_concurrent_arena_synchronized_pool)->Iterations(n_iterations)->ThreadRange(1, 8)->UseRealTime();
@@ -0,0 +1,53 @@
+#include <filesystem>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "containers/mapped_file_allocator.hpp"
+#include "containers/mapped_file_arena_mmr.hpp"
+
+#include "compiler_pragmas.hpp"
+
+using persisted_vector = std::vector<int, ml::mapped_file_allocator<int>>;
+
+static auto bm_file_path() -> std::filesystem::path {
+    return std::filesystem::temp_directory_path() / "ml_bm_mapped_file.bin";
+}
+
+// Startup cost of getting a large vector back, either by rebuilding it or by mapping a saved copy
+static void BM_mapped_file_rebuild(benchmark::State& state) {
+    auto const n_elems{static_cast<int>(state.range(0))};
+    for (auto _ : state) {
+        std::vector<int> vec;
+        for (int i{0}; i < n_elems; ++i) {
+            vec.push_back(i);
+        }
+        benchmark::DoNotOptimize(vec[vec.size() / 2]);
+    }
+    state.SetItemsProcessed(state.iterations() * n_elems);
+}
+static void BM_mapped_file_reopen(benchmark::State& state) {
+    auto const n_elems{static_cast<int>(state.range(0))};
+    auto const path{bm_file_path()};
+    std::filesystem::remove(path);
+    {
+        ml::mapped_file_arena_mmr arena{path};
+        auto& vec{arena.find_or_make_root<persisted_vector>(&arena)};
+        vec.reserve(static_cast<std::size_t>(n_elems));
+        for (int i{0}; i < n_elems; ++i) {
+            vec.push_back(i);
+        }
+        arena.sync();
+    }
+
+    for (auto _ : state) {
+        ml::mapped_file_arena_mmr arena{path};
+        auto& vec{arena.find_or_make_root<persisted_vector>(&arena)};
+        benchmark::DoNotOptimize(vec[vec.size() / 2]);
+    }
+    state.SetItemsProcessed(state.iterations() * n_elems);
+    std::filesystem::remove(path);
+}
+
+BENCHMARK(BM_mapped_file_rebuild)->RangeMultiplier(16)->Range(1 << 12, 1 << 24);
+BENCHMARK(BM_mapped_file_reopen)->RangeMultiplier(16)->Range(1 << 12, 1 << 24);
@@ -1,9 +1,12 @@
+#include <string>
 #include <vector>
 
 #include <benchmark/benchmark.h>
 
 #include "containers/arena_mmr.hpp"
+#include "containers/mmr_allocator.hpp"
 #include "containers/multi_arena_pmr.hpp"
+#include "containers/multi_t_arena_mmr.hpp"
 
 #include "compiler_pragmas.hpp"
 
@@ -93,8 +96,34 @@ static void BM_mixed_vector_multipool_t_allocator(benchmark::State& state) {
     }
     state.SetItemsProcessed(state.iterations() * n_placements * 3);
 }
+static void BM_mixed_vector_multipool_t_mmr_allocator(benchmark::State& state) {
+    using resource_type = ml::multi_t_arena_mmr<ml::arena_for<char, sizeof(char) * arena_elems_to_allocate>,
+                                                ml::arena_for<double, sizeof(double) * arena_elems_to_allocate>,
+                                                ml::arena_for<std::string, sizeof(std::string) * arena_elems_to_allocate>>;
+    // The characters come from the string arena, as they do for std::pmr::string in the pmr variants
+    using string_arena = resource_type::resource_type<std::string>;
+    using arena_string = std::basic_string<char, std::char_traits<char>, ml::mmr_allocator<char, string_arena>>;
+
+    for (auto _ : state) {
+        resource_type resource;
+        auto* strings{resource.get_resource<std::string>()};
+        ml::mmr_allocator<char, string_arena> string_char_alloc{strings};
+
+        std::vector<char, resource_type::allocator_type<char>> char_vec{resource.get_allocator<char>()};
+        std::vector<double, resource_type::allocator_type<double>> double_vec{resource.get_allocator<double>()};
+        std::vector<arena_string, ml::mmr_allocator<arena_string, string_arena>> string_vec{strings};
+
+        for (int i = 0; i < n_placements; ++i) {
+            char_vec.push_back(static_cast<char>(i % 256));
+            double_vec.push_back(i * 1.1);
+            string_vec.emplace_back(50, 'a' + (i % 26), string_char_alloc);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * n_placements * 3);
+}
 
 BENCHMARK(BM_mixed_vector_std);
 BENCHMARK(BM_mixed_vector_single_resource);
 BENCHMARK(BM_mixed_vector_multipool_allocator);
 BENCHMARK(BM_mixed_vector_multipool_t_allocator);
+BENCHMARK(BM_mixed_vector_multipool_t_mmr_allocator);
@@ -0,0 +1,134 @@
+#include <memory_resource>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "containers/bst.hpp"
+#include "containers/dlist.hpp"
+#include "containers/pmr.hpp"
+#include "containers/pmr_allocator.hpp"
+#include "containers/slab_pmr.hpp"
+#include "containers/stats_pmr.hpp"
+
+#include "bm_allocation_stats.hpp"
+#include "compiler_pragmas.hpp"
+
+static constexpr int n_live_nodes{1000};
+static constexpr int n_churn_ops{10'000};
+
+template <typename T>
+using std_pmr_allocator = std::pmr::polymorphic_allocator<T>;
+
+static auto random_keys() -> std::vector<int> const& {
+    static auto const keys{[] {
+        std::mt19937 rng{42};
+        std::uniform_int_distribution<int> dist{0, 1'000'000};
+        std::vector<int> out(n_live_nodes);
+        for (auto& key : out) {
+            key = dist(rng);
+        }
+        return out;
+    }()};
+    return keys;
+}
+
+// Keeps n_live_nodes alive while nodes are freed from the front and allocated at the back
+template <typename List>
+static void dlist_churn(List& list) {
+    for (int i = 0; i < n_live_nodes; ++i) {
+        list.push_back(i);
+    }
+    for (int i = 0; i < n_churn_ops; ++i) {
+        list.pop_front();
+        list.push_back(i);
+    }
+    list.clear();
+}
+// Builds a tree and tears it down again
+template <typename Tree>
+static void bst_churn(Tree& tree) {
+    auto const& keys{random_keys()};
+    for (int round = 0; round < n_churn_ops / n_live_nodes; ++round) {
+        for (auto const key : keys) {
+            tree.insert(key);
+        }
+        tree.clear();
+    }
+}
+
+static void BM_node_churn_dlist_std(benchmark::State& state) {
+    for (auto _ : state) {
+        ml::dlist<int> list;
+        dlist_churn(list);
+    }
+    state.SetItemsProcessed(state.iterations() * (n_live_nodes + n_churn_ops));
+}
+static void BM_node_churn_dlist_slab_pmr(benchmark::State& state) {
+    using list_type = ml::dlist<int, ml::pmr_allocator>;
+    ml::slab_pmr<ml::pmr> resource;
+
+    for (auto _ : state) {
+        list_type list{list_type::allocator_type{&resource}};
+        dlist_churn(list);
+    }
+    state.SetItemsProcessed(state.iterations() * (n_live_nodes + n_churn_ops));
+}
+static void BM_node_churn_dlist_slab_pmr_stats(benchmark::State& state) {
+    using list_type = ml::dlist<int, ml::pmr_allocator>;
+    ml::slab_pmr<ml::pmr> resource;
+    ml::stats_pmr stats{static_cast<ml::pmr*>(&resource), ml::stats_mode::single_thread};
+
+    for (auto _ : state) {
+        list_type list{list_type::allocator_type{&stats}};
+        dlist_churn(list);
+    }
+    state.SetItemsProcessed(state.iterations() * (n_live_nodes + n_churn_ops));
+    publish_allocation_stats(state, stats.stats());
+}
+static void BM_node_churn_dlist_unsync_pool(benchmark::State& state) {
+    using list_type = ml::dlist<int, std_pmr_allocator>;
+    std::pmr::unsynchronized_pool_resource resource;
+
+    for (auto _ : state) {
+        list_type list{list_type::allocator_type{&resource}};
+        dlist_churn(list);
+    }
+    state.SetItemsProcessed(state.iterations() * (n_live_nodes + n_churn_ops));
+}
+
+static void BM_node_churn_bst_std(benchmark::State& state) {
+    for (auto _ : state) {
+        ml::bst<int> tree;
+        bst_churn(tree);
+    }
+    state.SetItemsProcessed(state.iterations() * n_churn_ops);
+}
+static void BM_node_churn_bst_slab_pmr(benchmark::State& state) {
+    using tree_type = ml::bst<int, std::less<>, ml::pmr_allocator>;
+    ml::slab_pmr<ml::pmr> resource;
+
+    for (auto _ : state) {
+        tree_type tree{tree_type::allocator_type{&resource}};
+        bst_churn(tree);
+    }
+    state.SetItemsProcessed(state.iterations() * n_churn_ops);
+}
+static void BM_node_churn_bst_unsync_pool(benchmark::State& state) {
+    using tree_type = ml::bst<int, std::less<>, std_pmr_allocator>;
+    std::pmr::unsynchronized_pool_resource resource;
+
+    for (auto _ : state) {
+        tree_type tree{tree_type::allocator_type{&resource}};
+        bst_churn(tree);
+    }
+    state.SetItemsProcessed(state.iterations() * n_churn_ops);
+}
+
+BENCHMARK(BM_node_churn_dlist_std);
+BENCHMARK(BM_node_churn_dlist_slab_pmr);
+BENCHMARK(BM_node_churn_dlist_slab_pmr_stats);
+BENCHMARK(BM_node_churn_dlist_unsync_pool);
+BENCHMARK(BM_node_churn_bst_std);
+BENCHMARK(BM_node_churn_bst_slab_pmr);
+BENCHMARK(BM_node_churn_bst_unsync_pool);
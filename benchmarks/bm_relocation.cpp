@@ -0,0 +1,130 @@
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "containers/new_delete_pmr.hpp"
+#include "containers/pmr_allocator.hpp"
+#include "containers/relocation.hpp"
+#include "containers/vector.hpp"
+#include "containers/vector2.hpp"
+
+#include "compiler_pragmas.hpp"
+
+static constexpr int n_elems{10'000};
+
+namespace {
+struct pod {
+    int a;
+    double b;
+    char c[16];
+};
+
+// String which always keeps its characters on the heap so it never points into itself
+class heap_string {
+  public:
+    explicit heap_string(char const* str)
+        : size_{std::strlen(str)}
+        , data_{new char[size_ + 1]} {
+        std::memcpy(data_, str, size_ + 1);
+    }
+    heap_string(heap_string const& other)
+        : size_{other.size_}
+        , data_{new char[size_ + 1]} {
+        std::memcpy(data_, other.data_, size_ + 1);
+    }
+    heap_string(heap_string&& other) noexcept
+        : size_{std::exchange(other.size_, 0)}
+        , data_{std::exchange(other.data_, nullptr)} {}
+    ~heap_string() { delete[] data_; }
+
+    auto operator=(heap_string const&) -> heap_string& = delete;
+    auto operator=(heap_string&&) -> heap_string& = delete;
+  private:
+    std::size_t size_;
+    char* data_;
+};
+}
+
+template <>
+struct ml::is_trivially_relocatable<heap_string> : std::true_type {};
+
+static auto make_pod(int i) -> pod {
+    return pod{i, static_cast<double>(i), {}};
+}
+
+// Growth
+template <typename Vector, typename Make>
+static void grow(benchmark::State& state, Make make) {
+    for (auto _ : state) {
+        Vector vec;
+        for (int i = 0; i < n_elems; ++i) {
+            vec.push_back(make(i));
+        }
+        benchmark::DoNotOptimize(vec.data());
+    }
+    state.SetItemsProcessed(state.iterations() * n_elems);
+}
+static void BM_relocation_grow_pod_std(benchmark::State& state) {
+    grow<std::vector<pod>>(state, make_pod);
+}
+static void BM_relocation_grow_pod_ml(benchmark::State& state) {
+    grow<ml::vector<pod>>(state, make_pod);
+}
+static void BM_relocation_grow_heap_string_std(benchmark::State& state) {
+    grow<std::vector<heap_string>>(state, [](int) { return heap_string{"a string which will not fit in SSO"}; });
+}
+static void BM_relocation_grow_heap_string_ml(benchmark::State& state) {
+    grow<ml::vector<heap_string>>(state, [](int) { return heap_string{"a string which will not fit in SSO"}; });
+}
+static void BM_relocation_grow_std_string_ml(benchmark::State& state) {
+    grow<ml::vector<std::string>>(state, [](int) { return std::string{"a string which will not fit in SSO"}; });
+}
+static void BM_relocation_grow_heap_string_v2(benchmark::State& state) {
+    using vec_type = ml::vector2<heap_string, ml::pmr_allocator<heap_string>>;
+
+    for (auto _ : state) {
+        vec_type vec{ml::get_new_delete_pmr()};
+        for (int i = 0; i < n_elems; ++i) {
+            vec.emplace_back("a string which will not fit in SSO");
+        }
+        benchmark::DoNotOptimize(vec.data());
+    }
+    state.SetItemsProcessed(state.iterations() * n_elems);
+}
+
+// Copying
+template <typename Vector>
+static void copy(benchmark::State& state, Vector const& source) {
+    for (auto _ : state) {
+        Vector copy{source};
+        benchmark::DoNotOptimize(copy.data());
+    }
+    state.SetItemsProcessed(state.iterations() * n_elems);
+}
+static void BM_relocation_copy_pod_std(benchmark::State& state) {
+    std::vector<pod> source;
+    for (int i = 0; i < n_elems; ++i) {
+        source.push_back(make_pod(i));
+    }
+    copy(state, source);
+}
+static void BM_relocation_copy_pod_ml(benchmark::State& state) {
+    ml::vector<pod> source;
+    for (int i = 0; i < n_elems; ++i) {
+        source.push_back(make_pod(i));
+    }
+    copy(state, source);
+}
+
+BENCHMARK(BM_relocation_grow_pod_std);
+BENCHMARK(BM_relocation_grow_pod_ml);
+BENCHMARK(BM_relocation_grow_heap_string_std);
+BENCHMARK(BM_relocation_grow_heap_string_ml);
+BENCHMARK(BM_relocation_grow_std_string_ml);
+BENCHMARK(BM_relocation_grow_heap_string_v2);
+BENCHMARK(BM_relocation_copy_pod_std);
+BENCHMARK(BM_relocation_copy_pod_ml);
@@ -0,0 +1,102 @@
+#include <condition_variable>
+#include <cstddef>
+#include <memory_resource>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "containers/new_delete_pmr.hpp"
+#include "containers/pmr.hpp"
+#include "containers/slab_pmr.hpp"
+
+#include "compiler_pragmas.hpp"
+
+static constexpr int n_messages{256};
+static constexpr std::size_t message_bytes{64};
+
+namespace {
+// Hands batches of messages to a consumer thread which frees them
+template <typename Resource>
+class consumer {
+  public:
+    explicit consumer(Resource& resource)
+        : resource_{resource}
+        , thread_{[this] { run(); }} {}
+    ~consumer() {
+        {
+            std::scoped_lock lock{mutex_};
+            done_ = true;
+        }
+        cv_.notify_all();
+        thread_.join();
+    }
+
+    // Waits for the previous batch to be freed before handing over the next
+    void send(std::vector<void*>& batch) {
+        std::unique_lock lock{mutex_};
+        cv_.wait(lock, [this] { return pending_.empty(); });
+        pending_.swap(batch);
+        cv_.notify_all();
+    }
+  private:
+    void run() {
+        std::vector<void*> batch;
+        while (true) {
+            {
+                std::unique_lock lock{mutex_};
+                cv_.wait(lock, [this] { return done_ || !pending_.empty(); });
+                if (pending_.empty()) {
+                    return;
+                }
+                batch.swap(pending_);
+            }
+            cv_.notify_all();
+            for (auto* ptr : batch) {
+                resource_.deallocate(ptr, message_bytes, alignof(std::max_align_t));
+            }
+            batch.clear();
+        }
+    }
+
+    Resource& resource_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::vector<void*> pending_;
+    bool done_{false};
+    std::thread thread_;
+};
+}
+
+// The benchmark thread allocates messages and another thread frees them
+template <typename Resource>
+static void handoff(benchmark::State& state, Resource& resource) {
+    std::vector<void*> batch;
+    {
+        consumer<Resource> c{resource};
+        for (auto _ : state) {
+            for (int i{0}; i < n_messages; ++i) {
+                batch.push_back(resource.allocate(message_bytes, alignof(std::max_align_t)));
+            }
+            c.send(batch);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * n_messages);
+}
+
+static void BM_remote_free_new_delete(benchmark::State& state) {
+    handoff(state, *ml::get_new_delete_pmr<ml::pmr>());
+}
+static void BM_remote_free_slab_pmr(benchmark::State& state) {
+    ml::slab_pmr<ml::pmr> resource;
+    handoff(state, resource);
+}
+static void BM_remote_free_synchronized_pool(benchmark::State& state) {
+    std::pmr::synchronized_pool_resource resource;
+    handoff(state, resource);
+}
+
+BENCHMARK(BM_remote_free_new_delete)->UseRealTime();
+BENCHMARK(BM_remote_free_slab_pmr)->UseRealTime();
+BENCHMARK(BM_remote_free_synchronized_pool)->UseRealTime();
@@ -0,0 +1,74 @@
+#include <cstddef>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "containers/small_vector.hpp"
+#include "containers/static_vector.hpp"
+#include "containers/vector.hpp"
+
+#include "compiler_pragmas.hpp"
+
+static constexpr int n_lists{10'000};
+static constexpr std::size_t inline_capacity{16};
+
+// Builds many short lists, reads them back and destroys them
+// Lengths cycle from 0 to max_length so most lists are short
+template <typename List, typename Make>
+static void short_lists(benchmark::State& state, Make make) {
+    auto const max_length{static_cast<int>(state.range(0))};
+
+    for (auto _ : state) {
+        std::vector<List> lists(n_lists);
+        for (int i = 0; i < n_lists; ++i) {
+            auto const length{i % (max_length + 1)};
+            for (int j = 0; j < length; ++j) {
+                lists[i].push_back(make(j));
+            }
+        }
+
+        std::size_t total{0};
+        for (auto const& list : lists) {
+            total += list.size();
+        }
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(state.iterations() * n_lists);
+}
+
+static auto make_int(int i) -> int {
+    return i;
+}
+static auto make_string(int i) -> std::string {
+    return std::string(8, static_cast<char>('a' + i % 26));
+}
+
+static void BM_small_vector_int_std(benchmark::State& state) {
+    short_lists<std::vector<int>>(state, make_int);
+}
+static void BM_small_vector_int_ml_vector(benchmark::State& state) {
+    short_lists<ml::vector<int>>(state, make_int);
+}
+static void BM_small_vector_int_static_vector(benchmark::State& state) {
+    short_lists<ml::static_vector<int, inline_capacity>>(state, make_int);
+}
+static void BM_small_vector_int_small_vector(benchmark::State& state) {
+    short_lists<ml::small_vector<int, inline_capacity>>(state, make_int);
+}
+static void BM_small_vector_string_ml_vector(benchmark::State& state) {
+    short_lists<ml::vector<std::string>>(state, make_string);
+}
+static void BM_small_vector_string_small_vector(benchmark::State& state) {
+    short_lists<ml::small_vector<std::string, inline_capacity>>(state, make_string);
+}
+
+// static_vector can't hold more than its capacity so it only runs the short cases
+// A length of 0 measures constructing and destroying the lists alone
+BENCHMARK(BM_small_vector_int_std)->Arg(4)->Arg(16)->Arg(64);
+BENCHMARK(BM_small_vector_int_ml_vector)->Arg(4)->Arg(16)->Arg(64);
+BENCHMARK(BM_small_vector_int_static_vector)->Arg(0)->Arg(4)->Arg(16);
+BENCHMARK(BM_small_vector_int_small_vector)->Arg(0)->Arg(4)->Arg(16)->Arg(64);
+BENCHMARK(BM_small_vector_string_ml_vector)->Arg(4)->Arg(16)->Arg(64);
+BENCHMARK(BM_small_vector_string_small_vector)->Arg(4)->Arg(16)->Arg(64);
@@ -2,7 +2,9 @@
 
 #include <benchmark/benchmark.h>
 
+#include "containers/pmr_allocator.hpp"
 #include "containers/stack_pmr.hpp"
+#include "containers/vector2.hpp"
 
 #include "compiler_pragmas.hpp"
 
@@ -32,5 +34,60 @@ static void BM_stack_pmr_intvec_stack(benchmark::State& state) {
     state.SetItemsProcessed(state.iterations());
 }
 
+// The vector outgrows the initial reservation so later segments are chained and reused
+static void BM_stack_pmr_intvec_stack_overflow(benchmark::State& state) {
+    constexpr int n_many_ints{2000};
+    ml::stack_pmr stack;
+    stack.reserve(1 << 8);
+
+    for (auto _ : state) {
+        auto frame{stack.create_frame()};
+        std::pmr::vector<int> vec{frame.get()};
+        for (int i{0}; i < n_many_ints; ++i) {
+            vec.emplace_back(i);
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["segments"] = static_cast<double>(stack.n_segments());
+}
+
+// Compares the stack space used by growing vectors in a frame
+static void BM_stack_pmr_intvec_stack_bytes(benchmark::State& state) {
+    ml::stack_pmr stack;
+    stack.reserve(1 << 12);
+    std::size_t stack_bytes{0};
+
+    for (auto _ : state) {
+        auto frame{stack.create_frame()};
+        std::pmr::vector<int> vec{frame.get()};
+        for (int i{0}; i < n_ints; ++i) {
+            vec.emplace_back(i);
+        }
+        stack_bytes = stack.size();
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["stack_bytes"] = static_cast<double>(stack_bytes);
+}
+static void BM_stack_pmr_intvec2_stack_bytes(benchmark::State& state) {
+    using vec_type = ml::vector2<int, ml::pmr_allocator<int, ml::pmr>>;
+    ml::stack_pmr stack;
+    stack.reserve(1 << 12);
+    std::size_t stack_bytes{0};
+
+    for (auto _ : state) {
+        auto frame{stack.create_frame()};
+        vec_type vec{frame.get()};
+        for (int i{0}; i < n_ints; ++i) {
+            vec.emplace_back(i);
+        }
+        stack_bytes = stack.size();
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["stack_bytes"] = static_cast<double>(stack_bytes);
+}
+
 BENCHMARK(BM_stack_pmr_intvec_new);
 BENCHMARK(BM_stack_pmr_intvec_stack);
+BENCHMARK(BM_stack_pmr_intvec_stack_overflow);
+BENCHMARK(BM_stack_pmr_intvec_stack_bytes);
+BENCHMARK(BM_stack_pmr_intvec2_stack_bytes);
@@ -0,0 +1,51 @@
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+
+#include <benchmark/benchmark.h>
+
+#include "containers/new_delete_pmr.hpp"
+#include "containers/thread_cache_pmr.hpp"
+
+#include "compiler_pragmas.hpp"
+
+static constexpr int n_live{64};
+static constexpr std::array<std::size_t, 4> alloc_bytes{16, 32, 64, 128};
+
+// Each iteration frees and reallocates every block of a small working set, so blocks are reused
+// Threads touch the resource outside the timed loop, so shared resources live for the whole run
+template <typename Resource>
+static void churn(benchmark::State& state, Resource& resource) {
+    std::array<void*, n_live> live{};
+    for (int i{0}; i < n_live; ++i) {
+        live[i] = resource.allocate(alloc_bytes[i % alloc_bytes.size()], alignof(std::max_align_t));
+    }
+    for (auto _ : state) {
+        for (int i{0}; i < n_live; ++i) {
+            auto const bytes{alloc_bytes[i % alloc_bytes.size()]};
+            resource.deallocate(live[i], bytes, alignof(std::max_align_t));
+            live[i] = resource.allocate(bytes, alignof(std::max_align_t));
+        }
+        benchmark::DoNotOptimize(live.data());
+    }
+    for (int i{0}; i < n_live; ++i) {
+        resource.deallocate(live[i], alloc_bytes[i % alloc_bytes.size()], alignof(std::max_align_t));
+    }
+    state.SetItemsProcessed(state.iterations() * n_live);
+}
+
+static void BM_thread_cache_new_delete(benchmark::State& state) {
+    churn(state, *ml::get_new_delete_pmr<ml::pmr>());
+}
+static void BM_thread_cache_cached(benchmark::State& state) {
+    static ml::thread_cache_pmr resource;
+    churn(state, resource);
+}
+static void BM_thread_cache_synchronized_pool(benchmark::State& state) {
+    static std::pmr::synchronized_pool_resource resource;
+    churn(state, resource);
+}
+
+BENCHMARK(BM_thread_cache_new_delete)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_thread_cache_cached)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_thread_cache_synchronized_pool)->ThreadRange(1, 8)->UseRealTime();
@@ -5,6 +5,7 @@
 
 #include "containers/arena_mmr.hpp"
 #include "containers/multi_arena_pmr.hpp"
+#include "containers/object_arena_pmr.hpp"
 
 #include "compiler_pragmas.hpp"
 
@@ -109,6 +110,29 @@ static void BM_vec_list_wr_vector_alloc(benchmark::State& state) {
     }
     state.SetItemsProcessed(state.iterations() * ITER_ELEMS);
 }
+// The container is never destroyed directly, reset() runs its destructor and reuses the pools
+static void BM_vec_list_wr_vector_objects(benchmark::State& state) {
+    ml::object_arena_pmr resource{INITIAL_SIZE};
+
+    for (auto _ : state) {
+        auto& container{resource.make<std::pmr::vector<std::pmr::vector<TP>>>(&resource)};
+
+        for (int i = 0; i < n_placements; ++i) {
+            container.emplace_back();
+            auto& inner_container{container.back()};
+
+            for (int j = 0; j < n_reserve; j++) {
+                inner_container.emplace_back(i, &resource);
+            }
+        }
+
+#ifdef ITERATE_AFTER
+        READ_LOOP
+#endif
+        resource.reset();
+    }
+    state.SetItemsProcessed(state.iterations() * ITER_ELEMS);
+}
 static void BM_vec_list_wr_list_alloc(benchmark::State& state) {
     for (auto _ : state) {
         ml::arena_pmr resource{INITIAL_SIZE};
@@ -206,6 +230,7 @@ static void BM_vec_list_rd_list_alloc(benchmark::State& state) {
 
 BENCHMARK(BM_vec_list_wr_vector_std);
 BENCHMARK(BM_vec_list_wr_vector_alloc);
+BENCHMARK(BM_vec_list_wr_vector_objects);
 BENCHMARK(BM_vec_list_wr_list_std);
 BENCHMARK(BM_vec_list_wr_list_alloc);
 
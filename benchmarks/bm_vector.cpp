@@ -53,7 +53,26 @@ static void BM_vector_alloc_arena_pmr(benchmark::State& state) {
     }
     state.SetItemsProcessed(state.iterations() * n_placements);
 }
+// Same as above but the arena's pools are kept between iterations
+static void BM_vector_alloc_arena_pmr_reset(benchmark::State& state) {
+    ml::arena_pmr char_resource{sizeof(char) * arena_elems_to_allocate};
+
+    for (auto _ : state) {
+        {
+            std::vector<std::pmr::vector<char>> c_vecs;
+
+            for (int i = 0; i < n_placements; ++i) {
+                std::pmr::vector<char> char_vec{&char_resource};
+                char_vec.reserve(n_reserve);
+                c_vecs.emplace_back(std::move(char_vec));
+            }
+        }
+        char_resource.reset();
+    }
+    state.SetItemsProcessed(state.iterations() * n_placements);
+}
 
 BENCHMARK(BM_vector_alloc_std);
 BENCHMARK(BM_vector_alloc_arena);
 BENCHMARK(BM_vector_alloc_arena_pmr);
+BENCHMARK(BM_vector_alloc_arena_pmr_reset);
@@ -4,8 +4,13 @@
 
 #include "containers/vector2.hpp"
 #include "containers/pmr_allocator.hpp"
+#include "containers/arena_pmr.hpp"
 #include "containers/buffer_pmr.hpp"
+#include "containers/malloc_pmr.hpp"
+#include "containers/mmr_allocator.hpp"
+#include "containers/vm_arena_mmr.hpp"
 
+#include "bm_allocation_stats.hpp"
 #include "compiler_pragmas.hpp"
 
 template <typename T>
@@ -37,6 +42,107 @@ static void BM_vector2_v2_stack(benchmark::State& state) {
     }
     state.SetItemsProcessed(state.iterations() * n_placements);
 }
+// Reports the share of grows which extended the buffer in place
+static void BM_vector2_v2_arena(benchmark::State& state) {
+    ml::arena_pmr resource{std::size_t{1} << 20};
+    std::size_t n_grows{0};
+    std::size_t n_in_place{0};
+
+    for (auto _ : state) {
+        {
+            vec_pmr<int> vec{&resource};
+
+            for (int i = 0; i < n_placements; ++i) {
+                if (vec.full()) {
+                    auto const* old_data{vec.data()};
+                    vec.emplace_back(i);
+                    ++n_grows;
+                    n_in_place += (old_data && vec.data() == old_data);
+                } else {
+                    vec.emplace_back(i);
+                }
+            }
+        }
+        resource.reset();
+    }
+    state.SetItemsProcessed(state.iterations() * n_placements);
+    state.counters["in_place_grow_share"] = static_cast<double>(n_in_place) / static_cast<double>(n_grows);
+}
+static void BM_vector2_v2_arena_stats(benchmark::State& state) {
+    ml::arena_pmr resource{std::size_t{1} << 20};
+    ml::stats_pmr stats{static_cast<ml::pmr*>(&resource), ml::stats_mode::single_thread};
+
+    for (auto _ : state) {
+        {
+            vec_pmr<int> vec{&stats};
+
+            for (int i = 0; i < n_placements; ++i) {
+                vec.emplace_back(i);
+            }
+        }
+        resource.reset();
+    }
+    state.SetItemsProcessed(state.iterations() * n_placements);
+    publish_allocation_stats(state, stats.stats());
+}
+static void BM_vector2_std_arena(benchmark::State& state) {
+    ml::arena_pmr resource{std::size_t{1} << 20};
+
+    for (auto _ : state) {
+        {
+            std::pmr::vector<int> vec{&resource};
+
+            for (int i = 0; i < n_placements; ++i) {
+                vec.emplace_back(i);
+            }
+        }
+        resource.reset();
+    }
+    state.SetItemsProcessed(state.iterations() * n_placements);
+}
+static void BM_vector2_v2_vm_arena_large(benchmark::State& state) {
+    constexpr int n_large_placements{1'000'000};
+    using allocator = ml::mmr_allocator<int, ml::vm_arena_mmr>;
+
+    ml::vm_arena_options options;
+    options.reserve_bytes = std::size_t{256} << 20;
+    ml::vm_arena_mmr resource{options};
+
+    for (auto _ : state) {
+        ml::vector2<int, allocator> vec{allocator{&resource}};
+
+        for (int i = 0; i < n_large_placements; ++i) {
+            vec.emplace_back(i);
+        }
+        resource.reset();
+    }
+    state.SetItemsProcessed(state.iterations() * n_large_placements);
+}
+// Large buffers are grown with mremap instead of being copied
+static void BM_vector2_v2_malloc_large(benchmark::State& state) {
+    constexpr int n_large_placements{1'000'000};
+
+    for (auto _ : state) {
+        vec_pmr<int> vec{ml::get_malloc_pmr()};
+
+        for (int i = 0; i < n_large_placements; ++i) {
+            vec.emplace_back(i);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * n_large_placements);
+}
+static void BM_vector2_std_large(benchmark::State& state) {
+    constexpr int n_large_placements{1'000'000};
+
+    for (auto _ : state) {
+        std::vector<int> vec;
+
+        for (int i = 0; i < n_large_placements; ++i) {
+            vec.emplace_back(i);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * n_large_placements);
+}
 static void BM_vector2_std_iter(benchmark::State& state) {
     std::vector<int> vec;
     for (int i = 0; i < n_placements; ++i) {
@@ -65,7 +171,75 @@ static void BM_vector2_v2_stack_iter(benchmark::State& state) {
     state.SetItemsProcessed(state.iterations() * n_placements);
 }
 
+// Bulk appends in chunks, comparing element by element against append_range
+static constexpr int n_chunks{100};
+static constexpr int chunk_size{100};
+
+template <typename Append>
+static void arena_bulk(benchmark::State& state, Append append) {
+    ml::arena_pmr resource{std::size_t{1} << 20};
+    ml::stats_pmr stats{static_cast<ml::pmr*>(&resource), ml::stats_mode::single_thread};
+    std::vector<int> const chunk(chunk_size, 1);
+
+    for (auto _ : state) {
+        {
+            vec_pmr<int> vec{&stats};
+            for (int i = 0; i < n_chunks; ++i) {
+                append(vec, chunk);
+            }
+            benchmark::DoNotOptimize(vec.data());
+        }
+        resource.reset();
+    }
+    state.SetItemsProcessed(state.iterations() * n_chunks * chunk_size);
+    publish_allocation_stats(state, stats.stats());
+}
+static void BM_vector2_v2_arena_bulk_emplace(benchmark::State& state) {
+    arena_bulk(state, [](vec_pmr<int>& vec, std::vector<int> const& chunk) {
+        for (auto value : chunk) {
+            vec.emplace_back(value);
+        }
+    });
+}
+static void BM_vector2_v2_arena_bulk_append_range(benchmark::State& state) {
+    arena_bulk(state, [](vec_pmr<int>& vec, std::vector<int> const& chunk) { vec.append_range(chunk); });
+}
+static void BM_vector2_v2_arena_bulk_reserve(benchmark::State& state) {
+    arena_bulk(state, [](vec_pmr<int>& vec, std::vector<int> const& chunk) {
+        if (vec.empty()) {
+            vec.reserve(n_chunks * chunk_size);
+        }
+        vec.append_range(chunk);
+    });
+}
+static void BM_vector2_std_arena_bulk_insert(benchmark::State& state) {
+    ml::arena_pmr resource{std::size_t{1} << 20};
+    std::vector<int> const chunk(chunk_size, 1);
+
+    for (auto _ : state) {
+        {
+            std::pmr::vector<int> vec{&resource};
+            for (int i = 0; i < n_chunks; ++i) {
+                vec.insert(vec.end(), chunk.begin(), chunk.end());
+            }
+            benchmark::DoNotOptimize(vec.data());
+        }
+        resource.reset();
+    }
+    state.SetItemsProcessed(state.iterations() * n_chunks * chunk_size);
+}
+
 BENCHMARK(BM_vector2_std);
 BENCHMARK(BM_vector2_v2_stack);
+BENCHMARK(BM_vector2_v2_arena);
+BENCHMARK(BM_vector2_v2_arena_stats);
+BENCHMARK(BM_vector2_std_arena);
+BENCHMARK(BM_vector2_v2_vm_arena_large);
+BENCHMARK(BM_vector2_v2_malloc_large);
+BENCHMARK(BM_vector2_std_large);
 BENCHMARK(BM_vector2_std_iter);
 BENCHMARK(BM_vector2_v2_stack_iter);
+BENCHMARK(BM_vector2_v2_arena_bulk_emplace);
+BENCHMARK(BM_vector2_v2_arena_bulk_append_range);
+BENCHMARK(BM_vector2_v2_arena_bulk_reserve);
+BENCHMARK(BM_vector2_std_arena_bulk_insert);
@@ -0,0 +1,191 @@
+#include <list>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "containers/vector.hpp"
+
+#include "compiler_pragmas.hpp"
+
+static constexpr int n_chunks{100};
+static constexpr int chunk_size{1000};
+
+static auto make_chunk() -> std::vector<int> {
+    std::vector<int> chunk(chunk_size);
+    std::iota(chunk.begin(), chunk.end(), 0);
+    return chunk;
+}
+
+// Appending
+static void BM_vector_bulk_append_int_std(benchmark::State& state) {
+    auto const chunk{make_chunk()};
+    for (auto _ : state) {
+        std::vector<int> vec;
+        for (int i = 0; i < n_chunks; ++i) {
+            vec.insert(vec.end(), chunk.begin(), chunk.end());
+        }
+        benchmark::DoNotOptimize(vec.data());
+    }
+    state.SetItemsProcessed(state.iterations() * n_chunks * chunk_size);
+}
+static void BM_vector_bulk_append_int_ml(benchmark::State& state) {
+    auto const chunk{make_chunk()};
+    for (auto _ : state) {
+        ml::vector<int> vec;
+        for (int i = 0; i < n_chunks; ++i) {
+            vec.append_range(chunk);
+        }
+        benchmark::DoNotOptimize(vec.data());
+    }
+    state.SetItemsProcessed(state.iterations() * n_chunks * chunk_size);
+}
+// Element by element, which is what callers had to do before append_range
+static void BM_vector_bulk_append_int_ml_push_back(benchmark::State& state) {
+    auto const chunk{make_chunk()};
+    for (auto _ : state) {
+        ml::vector<int> vec;
+        for (int i = 0; i < n_chunks; ++i) {
+            for (auto value : chunk) {
+                vec.push_back(value);
+            }
+        }
+        benchmark::DoNotOptimize(vec.data());
+    }
+    state.SetItemsProcessed(state.iterations() * n_chunks * chunk_size);
+}
+static void BM_vector_bulk_append_list_std(benchmark::State& state) {
+    auto const chunk{make_chunk()};
+    std::list<int> const source(chunk.begin(), chunk.end());
+    for (auto _ : state) {
+        std::vector<int> vec;
+        for (int i = 0; i < n_chunks; ++i) {
+            vec.insert(vec.end(), source.begin(), source.end());
+        }
+        benchmark::DoNotOptimize(vec.data());
+    }
+    state.SetItemsProcessed(state.iterations() * n_chunks * chunk_size);
+}
+static void BM_vector_bulk_append_list_ml(benchmark::State& state) {
+    auto const chunk{make_chunk()};
+    std::list<int> const source(chunk.begin(), chunk.end());
+    for (auto _ : state) {
+        ml::vector<int> vec;
+        for (int i = 0; i < n_chunks; ++i) {
+            vec.append_range(source);
+        }
+        benchmark::DoNotOptimize(vec.data());
+    }
+    state.SetItemsProcessed(state.iterations() * n_chunks * chunk_size);
+}
+
+// Inserting at the front
+static void BM_vector_bulk_insert_front_int_std(benchmark::State& state) {
+    auto const chunk{make_chunk()};
+    for (auto _ : state) {
+        std::vector<int> vec;
+        for (int i = 0; i < n_chunks; ++i) {
+            vec.insert(vec.begin(), chunk.begin(), chunk.end());
+        }
+        benchmark::DoNotOptimize(vec.data());
+    }
+    state.SetItemsProcessed(state.iterations() * n_chunks * chunk_size);
+}
+static void BM_vector_bulk_insert_front_int_ml(benchmark::State& state) {
+    auto const chunk{make_chunk()};
+    for (auto _ : state) {
+        ml::vector<int> vec;
+        for (int i = 0; i < n_chunks; ++i) {
+            vec.insert_range(vec.begin(), chunk);
+        }
+        benchmark::DoNotOptimize(vec.data());
+    }
+    state.SetItemsProcessed(state.iterations() * n_chunks * chunk_size);
+}
+static void BM_vector_bulk_insert_front_string_std(benchmark::State& state) {
+    std::vector<std::string> const chunk(chunk_size / 10, "a string which will not fit in SSO");
+    for (auto _ : state) {
+        std::vector<std::string> vec;
+        for (int i = 0; i < n_chunks; ++i) {
+            vec.insert(vec.begin(), chunk.begin(), chunk.end());
+        }
+        benchmark::DoNotOptimize(vec.data());
+    }
+    state.SetItemsProcessed(state.iterations() * n_chunks * (chunk_size / 10));
+}
+static void BM_vector_bulk_insert_front_string_ml(benchmark::State& state) {
+    std::vector<std::string> const chunk(chunk_size / 10, "a string which will not fit in SSO");
+    for (auto _ : state) {
+        ml::vector<std::string> vec;
+        for (int i = 0; i < n_chunks; ++i) {
+            vec.insert_range(vec.begin(), chunk);
+        }
+        benchmark::DoNotOptimize(vec.data());
+    }
+    state.SetItemsProcessed(state.iterations() * n_chunks * (chunk_size / 10));
+}
+
+// Erasing from the front
+static void BM_vector_bulk_erase_front_int_std(benchmark::State& state) {
+    for (auto _ : state) {
+        std::vector<int> vec(n_chunks * chunk_size);
+        while (!vec.empty()) {
+            vec.erase(vec.begin(), vec.begin() + chunk_size);
+        }
+        benchmark::DoNotOptimize(vec.data());
+    }
+    state.SetItemsProcessed(state.iterations() * n_chunks * chunk_size);
+}
+static void BM_vector_bulk_erase_front_int_ml(benchmark::State& state) {
+    for (auto _ : state) {
+        ml::vector<int> vec;
+        vec.resize(n_chunks * chunk_size);
+        while (!vec.empty()) {
+            vec.erase(vec.begin(), vec.begin() + chunk_size);
+        }
+        benchmark::DoNotOptimize(vec.data());
+    }
+    state.SetItemsProcessed(state.iterations() * n_chunks * chunk_size);
+}
+
+// Resizing
+static void BM_vector_bulk_resize_std(benchmark::State& state) {
+    for (auto _ : state) {
+        std::vector<int> vec;
+        vec.resize(n_chunks * chunk_size);
+        benchmark::DoNotOptimize(vec.data());
+    }
+    state.SetItemsProcessed(state.iterations() * n_chunks * chunk_size);
+}
+static void BM_vector_bulk_resize_ml(benchmark::State& state) {
+    for (auto _ : state) {
+        ml::vector<int> vec;
+        vec.resize(n_chunks * chunk_size);
+        benchmark::DoNotOptimize(vec.data());
+    }
+    state.SetItemsProcessed(state.iterations() * n_chunks * chunk_size);
+}
+static void BM_vector_bulk_resize_for_overwrite_ml(benchmark::State& state) {
+    for (auto _ : state) {
+        ml::vector<int> vec;
+        vec.resize_for_overwrite(n_chunks * chunk_size);
+        benchmark::DoNotOptimize(vec.data());
+    }
+    state.SetItemsProcessed(state.iterations() * n_chunks * chunk_size);
+}
+
+BENCHMARK(BM_vector_bulk_append_int_std);
+BENCHMARK(BM_vector_bulk_append_int_ml);
+BENCHMARK(BM_vector_bulk_append_int_ml_push_back);
+BENCHMARK(BM_vector_bulk_append_list_std);
+BENCHMARK(BM_vector_bulk_append_list_ml);
+BENCHMARK(BM_vector_bulk_insert_front_int_std);
+BENCHMARK(BM_vector_bulk_insert_front_int_ml);
+BENCHMARK(BM_vector_bulk_insert_front_string_std);
+BENCHMARK(BM_vector_bulk_insert_front_string_ml);
+BENCHMARK(BM_vector_bulk_erase_front_int_std);
+BENCHMARK(BM_vector_bulk_erase_front_int_ml);
+BENCHMARK(BM_vector_bulk_resize_std);
+BENCHMARK(BM_vector_bulk_resize_ml);
+BENCHMARK(BM_vector_bulk_resize_for_overwrite_ml);
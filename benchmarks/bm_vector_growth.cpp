@@ -0,0 +1,118 @@
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "containers/allocator.hpp"
+#include "containers/allocator_concepts.hpp"
+#include "containers/vector.hpp"
+
+#include "compiler_pragmas.hpp"
+
+static constexpr int n_pushes{1'000'000};
+
+namespace {
+// 12 bytes so allocator slack doesn't line up with whole elements
+struct element {
+    int a;
+    int b;
+    int c;
+};
+
+struct growth_stats {
+    std::size_t n_allocations{0};
+    std::size_t bytes_freed{0};
+};
+
+// Counts allocations and the bytes handed back, which a push-only vector has always copied out first
+template <typename T, typename Base>
+struct counting_allocator : Base {
+    using value_type = T;
+
+    static inline growth_stats stats{};
+
+    counting_allocator() = default;
+    template <typename U>
+    counting_allocator(counting_allocator<U, typename std::allocator_traits<Base>::template rebind_alloc<U>> const&) {}
+
+    template <typename U>
+    struct rebind {
+        using other = counting_allocator<U, typename std::allocator_traits<Base>::template rebind_alloc<U>>;
+    };
+
+    auto allocate(std::size_t n) -> T* {
+        ++stats.n_allocations;
+        return Base::allocate(n);
+    }
+    auto allocate_at_least(std::size_t n)
+        requires ml::at_least_allocator<Base>
+    {
+        ++stats.n_allocations;
+        return Base::allocate_at_least(n);
+    }
+    void deallocate(T* ptr, std::size_t n) {
+        if (ptr) {
+            stats.bytes_freed += n * sizeof(T);
+        }
+        Base::deallocate(ptr, n);
+    }
+
+    friend auto operator==(counting_allocator const&, counting_allocator const&) -> bool { return true; }
+};
+}
+
+// Reports the reallocations and bytes copied while pushing a million elements, and the capacity left unused
+template <typename Vector>
+static void push(benchmark::State& state) {
+    using allocator_type = typename Vector::allocator_type;
+    auto const avg{benchmark::Counter::kAvgIterations};
+
+    growth_stats totals{};
+    std::size_t slack_bytes{0};
+    for (auto _ : state) {
+        allocator_type::stats = {};
+        Vector vec;
+        for (int i = 0; i < n_pushes; ++i) {
+            vec.push_back(element{i, i, i});
+        }
+        benchmark::DoNotOptimize(vec.data());
+
+        totals.n_allocations += allocator_type::stats.n_allocations;
+        totals.bytes_freed += allocator_type::stats.bytes_freed;
+        slack_bytes = (vec.capacity() - vec.size()) * sizeof(element);
+    }
+    state.counters["reallocs"] = benchmark::Counter(static_cast<double>(totals.n_allocations - state.iterations()), avg);
+    state.counters["bytes_copied"] = benchmark::Counter(static_cast<double>(totals.bytes_freed), avg);
+    state.counters["slack_bytes"] = static_cast<double>(slack_bytes);
+    state.SetItemsProcessed(state.iterations() * n_pushes);
+}
+
+using std_counting = counting_allocator<element, std::allocator<element>>;
+using ml_counting = counting_allocator<element, ml::allocator<element>>;
+
+static void BM_vector_growth_std(benchmark::State& state) {
+    push<std::vector<element, std_counting>>(state);
+}
+static void BM_vector_growth_ml_2x(benchmark::State& state) {
+    push<ml::vector<element, std_counting, ml::vector_growth_2x>>(state);
+}
+static void BM_vector_growth_ml_1_5x(benchmark::State& state) {
+    push<ml::vector<element, std_counting, ml::vector_growth_1_5x>>(state);
+}
+static void BM_vector_growth_ml_1_5x_paged(benchmark::State& state) {
+    push<ml::vector<element, std_counting, ml::vector_growth_1_5x_paged>>(state);
+}
+static void BM_vector_growth_ml_2x_at_least(benchmark::State& state) {
+    push<ml::vector<element, ml_counting, ml::vector_growth_2x>>(state);
+}
+static void BM_vector_growth_ml_1_5x_paged_at_least(benchmark::State& state) {
+    push<ml::vector<element, ml_counting, ml::vector_growth_1_5x_paged>>(state);
+}
+
+BENCHMARK(BM_vector_growth_std);
+BENCHMARK(BM_vector_growth_ml_2x);
+BENCHMARK(BM_vector_growth_ml_1_5x);
+BENCHMARK(BM_vector_growth_ml_1_5x_paged);
+BENCHMARK(BM_vector_growth_ml_2x_at_least);
+BENCHMARK(BM_vector_growth_ml_1_5x_paged_at_least);
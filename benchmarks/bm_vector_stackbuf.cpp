@@ -1,3 +1,4 @@
+#include <memory_resource>
 #include <vector>
 
 #include <benchmark/benchmark.h>
@@ -35,5 +36,44 @@ static void BM_vector_stackbuf(benchmark::State& state) {
     state.SetItemsProcessed(state.iterations());
 }
 
+// Most vectors fit the buffer, every 16th overflows to the heap
+static void BM_vector_stackbuf_upstream(benchmark::State& state) {
+    static constexpr std::size_t n_ints{50};
+    static constexpr std::size_t n_overflow_ints{500};
+    using config = ml::StackAllocConfig<int, n_ints>;
+
+    std::size_t n{0};
+    for (auto _ : state) {
+        auto const n_elems{(++n % 16) ? n_ints : n_overflow_ints};
+
+        config::Resource resource{std::pmr::new_delete_resource()};
+        config::Allocator alloc{&resource};
+        std::vector<int, config::Allocator> vec{alloc};
+        vec.reserve(n_ints);
+        for (std::size_t i{0}; i < n_elems; ++i) {
+            vec.emplace_back(static_cast<int>(i));
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+static void BM_vector_stackbuf_new_ref_mixed(benchmark::State& state) {
+    static constexpr std::size_t n_ints{50};
+    static constexpr std::size_t n_overflow_ints{500};
+
+    std::size_t n{0};
+    for (auto _ : state) {
+        auto const n_elems{(++n % 16) ? n_ints : n_overflow_ints};
+
+        std::vector<int> vec{};
+        vec.reserve(n_ints);
+        for (std::size_t i{0}; i < n_elems; ++i) {
+            vec.emplace_back(static_cast<int>(i));
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
 BENCHMARK(BM_vector_stackbuf_new_ref);
 BENCHMARK(BM_vector_stackbuf);
+BENCHMARK(BM_vector_stackbuf_upstream);
+BENCHMARK(BM_vector_stackbuf_new_ref_mixed);
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <cstddef>
 #include <memory>
 #include <new>
@@ -7,7 +8,7 @@
 #include "allocator_concepts.hpp"
 
 namespace ml {
-// Inherited std::allocator to add allocate_bytes and deallocate_bytes
+// Inherited std::allocator to add allocate_bytes, deallocate_bytes and allocate_at_least
 template <typename T>
 class allocator : public std::allocator<T> {
   public:
@@ -18,6 +19,9 @@ class allocator : public std::allocator<T> {
 
     auto allocate_bytes(size_type size, size_type alignment = alignof(std::max_align_t)) -> void*;
     void deallocate_bytes(void* ptr, size_type size, size_type alignment = alignof(std::max_align_t));
+
+    // operator new hands out blocks in multiples of the fundamental alignment so the rest is usable
+    [[nodiscard]] auto allocate_at_least(size_type n) -> allocation_result<T*, size_type>;
 };
 
 template <typename T>
@@ -25,6 +29,14 @@ inline auto allocator<T>::allocate_bytes(size_type size, size_type alignment) ->
     return ::operator new(size, std::align_val_t{alignment});
 }
 
+template <typename T>
+inline auto allocator<T>::allocate_at_least(size_type n) -> allocation_result<T*, size_type> {
+    constexpr size_type granularity{alignof(std::max_align_t)};
+    auto const n_bytes{((n * sizeof(T) + granularity - 1) / granularity) * granularity};
+    auto const count{std::max(n, n_bytes / sizeof(T))};
+    return {this->allocate(count), count};
+}
+
 template <typename T>
 inline void allocator<T>::deallocate_bytes(void* ptr, size_type size, size_type alignment) {
     ::operator delete(ptr, size, std::align_val_t{alignment});
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <concepts>
 #include <cstddef>
 
 namespace ml {
@@ -14,4 +15,26 @@ concept extendable_allocator =
     requires(T t, void* ptr, std::size_t old_bytes, std::size_t new_bytes, std::size_t alignment) {
         { t.extend_bytes(ptr, old_bytes, new_bytes, alignment) } -> std::same_as<void*>;
     };
+
+// The allocator can move a trivially relocatable allocation itself when resizing it
+template <typename T>
+concept reallocatable_allocator =
+    requires(T t, void* ptr, std::size_t old_bytes, std::size_t new_bytes, std::size_t alignment) {
+        { t.reallocate_bytes(ptr, old_bytes, new_bytes, alignment) } -> std::same_as<void*>;
+    };
+
+// Memory returned by allocate_at_least and the number of objects it really holds
+template <typename Pointer, typename SizeType = std::size_t>
+struct allocation_result {
+    Pointer ptr;
+    SizeType count;
+};
+
+// The allocator can report the slack in an allocation so containers can use it as capacity
+// The block must later be deallocated with the returned count
+template <typename T>
+concept at_least_allocator = requires(T t, std::size_t n) {
+    { t.allocate_at_least(n).ptr } -> std::convertible_to<typename T::value_type*>;
+    { t.allocate_at_least(n).count } -> std::convertible_to<std::size_t>;
+};
 }
@@ -1,46 +1,247 @@
+#include <algorithm>
 #include <cmath>
+#include <utility>
 
 #include "arena_mmr.hpp"
-#include "misc.hpp"
 
 namespace ml {
-arena_mmr::arena_mmr(size_type initial_capacity)
-    : initial_capacity_{initial_capacity} {}
+arena_mmr::arena_mmr(size_type initial_capacity, size_type max_retained_bytes)
+    : initial_capacity_{initial_capacity}
+    , max_retained_bytes_{max_retained_bytes} {}
+arena_mmr::arena_mmr(size_type initial_capacity, arena_growth_policy const& policy, size_type max_retained_bytes)
+    : initial_capacity_{initial_capacity}
+    , max_retained_bytes_{max_retained_bytes}
+    , policy_{policy} {}
 arena_mmr::arena_mmr(arena_mmr&& other)
     : pool_{other.pool_}
-    , last_pool_{other.last_pool_} {
+    , last_pool_{other.last_pool_}
+    , initial_capacity_{other.initial_capacity_}
+    , max_retained_bytes_{other.max_retained_bytes_}
+    , policy_{other.policy_}
+    , dedicated_{other.dedicated_}
+    , dedicated_size_{other.dedicated_size_}
+    , n_pools_{other.n_pools_}
+    , total_capacity_{other.total_capacity_}
+    , prior_size_{other.prior_size_}
+    , pending_pool_{std::move(other.pending_pool_)} {
     other.pool_ = nullptr;
     other.last_pool_ = nullptr;
+    other.dedicated_ = nullptr;
+    other.dedicated_size_ = 0;
+    other.n_pools_ = 0;
+    other.total_capacity_ = 0;
+    other.prior_size_ = 0;
 }
 
 auto arena_mmr::operator=(arena_mmr&& other) -> arena_mmr& {
     if (this != &other) {
+        collect_pending_pool();
         if (pool_) {
-            pool_->~arena_mmr_pool();
-            delete[] reinterpret_cast<std::byte*>(pool_);
+            destroy_pool(pool_);
+        }
+        if (dedicated_) {
+            destroy_pool(dedicated_);
         }
         pool_ = other.pool_;
         last_pool_ = other.last_pool_;
+        initial_capacity_ = other.initial_capacity_;
+        max_retained_bytes_ = other.max_retained_bytes_;
+        policy_ = other.policy_;
+        dedicated_ = other.dedicated_;
+        dedicated_size_ = other.dedicated_size_;
+        n_pools_ = other.n_pools_;
+        total_capacity_ = other.total_capacity_;
+        prior_size_ = other.prior_size_;
+        pending_pool_ = std::move(other.pending_pool_);
         other.pool_ = nullptr;
         other.last_pool_ = nullptr;
+        other.dedicated_ = nullptr;
+        other.dedicated_size_ = 0;
+        other.n_pools_ = 0;
+        other.total_capacity_ = 0;
+        other.prior_size_ = 0;
     }
     return *this;
 }
 
-auto arena_mmr::allocate(size_type n_bytes, size_type alignment) -> void* {
-    auto make_new_size{[](auto cap, auto n_b) { return ml::max(cap, (n_b / cap) * size_type{2} * cap); }};
+auto arena_mmr::allocate_slow(size_type n_bytes, size_type alignment) -> void* {
+    if (n_bytes >= policy_.dedicated_threshold) {
+        return allocate_dedicated(n_bytes, alignment);
+    }
+    if (!last_pool_ || !last_pool_->can_allocate(n_bytes, alignment)) {
+        advance_pool(n_bytes, alignment);
+    }
+
+    auto* ptr{last_pool_->allocate(n_bytes, alignment)};
+    if (policy_.prepare_high_water < 1.0) {
+        auto const high_water{policy_.prepare_high_water * static_cast<double>(last_pool_->total_capacity())};
+        if (static_cast<double>(last_pool_->size()) > high_water && !next_pool_ready()) {
+            prepare_next_pool_async();
+        }
+    }
+    return ptr;
+}
+
+void arena_mmr::reset() {
+    release_dedicated_until(nullptr);
+    dedicated_size_ = 0;
+
+    // Keep pools from the front until the retention limit is reached
+    arena_mmr_pool* last_kept{nullptr};
+    size_type kept_bytes{0};
+    size_type kept_pools{0};
+    for (auto* p{pool_}; p; p = p->next_pool_) {
+        if (kept_bytes + p->total_capacity() > max_retained_bytes_) {
+            break;
+        }
+        kept_bytes += p->total_capacity();
+        ++kept_pools;
+        last_kept = p;
+    }
+
+    if (last_kept) {
+        release_pools_after(last_kept);
+        pool_->rewind_to(0);
+    } else if (pool_) {
+        destroy_pool(pool_);
+        pool_ = nullptr;
+    }
+    last_pool_ = pool_;
+    n_pools_ = kept_pools;
+    total_capacity_ = kept_bytes;
+    prior_size_ = 0;
+}
+
+void arena_mmr::advance_pool(size_type n_bytes, size_type alignment) {
+    // Leave room for the worst-case alignment padding
+    auto const bytes_needed{n_bytes + alignment};
+
+    collect_pending_pool();
+    // A prepared pool may have just become the first one
+    if (last_pool_ && last_pool_->can_allocate(n_bytes, alignment)) {
+        return;
+    }
 
     if (!last_pool_) {
-        auto const cap{initial_capacity_};
-        pool_ = arena_mmr_pool::create_pool(make_new_size(cap, n_bytes));
+        // The first pool starts from the initial capacity whatever the curve
+        auto const first_size{std::max(initial_capacity_, (bytes_needed / initial_capacity_) * 2 * initial_capacity_)};
+        pool_ = arena_mmr_pool::create_pool(std::max(std::min(first_size, policy_.max_pool_size), bytes_needed));
         last_pool_ = pool_;
-    } else if (last_pool_->remaining_capacity() <= n_bytes) {
-        auto const cap{last_pool_->total_capacity()};
-        last_pool_->next_pool_ = arena_mmr_pool::create_pool(make_new_size(cap, n_bytes));
-        last_pool_ = last_pool_->next_pool_;
+        // Dedicated pools may already be counted
+        ++n_pools_;
+        total_capacity_ += pool_->total_capacity();
+        prior_size_ = 0;
+        return;
+    }
+
+    // Reuse the next kept pool if the allocation fits
+    if (auto* next{last_pool_->next_pool_}) {
+        next->rewind_to(0);
+        if (next->can_allocate(n_bytes, alignment)) {
+            prior_size_ += last_pool_->size();
+            last_pool_ = next;
+            return;
+        }
+    }
+
+    auto* fresh{arena_mmr_pool::create_pool(next_pool_size(last_pool_->total_capacity(), bytes_needed))};
+    fresh->next_pool_ = last_pool_->next_pool_;
+    last_pool_->next_pool_ = fresh;
+    prior_size_ += last_pool_->size();
+    last_pool_ = fresh;
+    ++n_pools_;
+    total_capacity_ += fresh->total_capacity();
+}
+auto arena_mmr::next_pool_size(size_type previous_capacity, size_type bytes_needed) const -> size_type {
+    size_type size{0};
+    switch (policy_.curve) {
+        case arena_growth_curve::fixed:
+            size = std::max(previous_capacity, (bytes_needed / previous_capacity) * 2 * previous_capacity);
+            break;
+        case arena_growth_curve::geometric:
+            size = previous_capacity * 2;
+            break;
     }
+    return std::max(std::min(size, policy_.max_pool_size), bytes_needed);
+}
+auto arena_mmr::allocate_dedicated(size_type n_bytes, size_type alignment) -> void* {
+    auto* pool{arena_mmr_pool::create_pool(n_bytes + alignment)};
+    auto* ptr{pool->allocate(n_bytes, alignment)};
+    pool->next_pool_ = dedicated_;
+    dedicated_ = pool;
+    dedicated_size_ += pool->size();
+    ++n_pools_;
+    total_capacity_ += pool->total_capacity();
+    return ptr;
+}
+void arena_mmr::release_dedicated_until(arena_mmr_pool* last) {
+    while (dedicated_ && dedicated_ != last) {
+        auto* next{dedicated_->next_pool_};
+        --n_pools_;
+        total_capacity_ -= dedicated_->total_capacity();
+        dedicated_->next_pool_ = nullptr;
+        destroy_pool(dedicated_);
+        dedicated_ = next;
+    }
+}
+void arena_mmr::release_pools_after(arena_mmr_pool* pool) {
+    if (auto* next{pool->next_pool_}) {
+        destroy_pool(next);
+        pool->next_pool_ = nullptr;
+    }
+}
+void arena_mmr::destroy_pool(arena_mmr_pool* pool) {
+    pool->~arena_mmr_pool();
+    delete[] reinterpret_cast<std::byte*>(pool);
+}
+
+namespace {
+auto create_prefaulted_pool(std::size_t size) -> arena_mmr_pool* {
+    // Pages are at least this big so writing one byte per step faults in every page
+    constexpr std::size_t page_step{4096};
+
+    auto* pool{arena_mmr_pool::create_pool(size)};
+    auto* data{pool->data()};
+    for (std::size_t i{0}; i < size; i += page_step) {
+        data[i] = std::byte{0};
+    }
+    return pool;
+}
+}
 
-    return last_pool_->allocate(n_bytes, alignment);
+void arena_mmr::prepare_next_pool() {
+    collect_pending_pool();
+    if (!next_pool_ready()) {
+        adopt_pool(create_prefaulted_pool(prepared_pool_size()));
+    }
+}
+void arena_mmr::prepare_next_pool_async() {
+    if (!next_pool_ready()) {
+        pending_pool_ = std::async(std::launch::async, create_prefaulted_pool, prepared_pool_size());
+    }
+}
+auto arena_mmr::prepared_pool_size() const -> size_type {
+    if (!last_pool_) {
+        return std::min(initial_capacity_, policy_.max_pool_size);
+    }
+    return next_pool_size(last_pool_->total_capacity(), 0);
+}
+void arena_mmr::adopt_pool(arena_mmr_pool* pool) {
+    if (!last_pool_) {
+        pool_ = pool;
+        last_pool_ = pool;
+        prior_size_ = 0;
+    } else {
+        pool->next_pool_ = last_pool_->next_pool_;
+        last_pool_->next_pool_ = pool;
+    }
+    ++n_pools_;
+    total_capacity_ += pool->total_capacity();
+}
+void arena_mmr::collect_pending_pool() {
+    if (pending_pool_.valid()) {
+        adopt_pool(pending_pool_.get());
+    }
 }
 
 }
@@ -1,17 +1,64 @@
 ﻿#pragma once
 
 #include <cstddef>
+#include <future>
+#include <limits>
 
 #include "arena_mmr_pool.hpp"
 #include "mmr_allocator.hpp"
 
 namespace ml {
+// A saved arena position which can be rewound to
+// Marks are invalidated by reset() as it may release the pool they point into
+struct arena_mmr_mark {
+    arena_mmr_pool* pool{nullptr};
+    std::size_t size{0};
+    // Bytes used by the pools before pool
+    std::size_t prior_size{0};
+    // Most recent dedicated pool
+    arena_mmr_pool* dedicated{nullptr};
+    std::size_t dedicated_size{0};
+};
+
+enum class arena_growth_curve {
+    // A new pool matches the previous one unless the request needs more
+    fixed,
+    // Each new pool doubles the previous one
+    geometric
+};
+
+// max_pool_size caps either curve, use geometric with a cap for capped growth
+// A pool is always large enough for the request that created it
+struct arena_growth_policy {
+    arena_growth_curve curve{arena_growth_curve::fixed};
+    std::size_t max_pool_size{std::numeric_limits<std::size_t>::max()};
+    // Requests of at least this many bytes get a pool of their own so the active pool keeps its free space
+    std::size_t dedicated_threshold{std::numeric_limits<std::size_t>::max()};
+    // Once this fraction of the active pool is in use the next pool is made and pre-faulted on a helper thread,
+    // so moving to it doesn't stall. 1 turns this off
+    double prepare_high_water{1.0};
+};
+
+/*
+Pools are kept after reset() and rewind() and reused in order by later allocations.
+A request which doesn't fit the next kept pool gets a new pool spliced in ahead of it.
+max_retained_bytes caps the pool capacity reset() keeps, the rest is returned to delete[].
+Dedicated pools are never kept.
+prepare_next_pool() makes and pre-faults the pool after the active one ahead of time,
+so crossing into it only swaps a pointer. Arenas used from one thread can have it done on a helper thread,
+see arena_growth_policy::prepare_high_water.
+*/
 class arena_mmr {
   public:
     using size_type = std::size_t;
 
+    static inline constexpr size_type retain_all{std::numeric_limits<size_type>::max()};
+
     arena_mmr() = default;
-    explicit arena_mmr(size_type initial_capacity);
+    explicit arena_mmr(size_type initial_capacity, size_type max_retained_bytes = retain_all);
+    arena_mmr(size_type initial_capacity,
+              arena_growth_policy const& policy,
+              size_type max_retained_bytes = retain_all);
     ~arena_mmr();
 
     arena_mmr(arena_mmr const&) = delete;
@@ -22,54 +69,122 @@ class arena_mmr {
 
     // Access
     auto pool() const -> arena_mmr_pool const*;
+    auto policy() const -> arena_growth_policy const&;
 
     // Capacity
     auto initial_capacity() const -> size_type;
     auto n_pools() const -> size_type;
     auto total_size() const -> size_type;
+    auto total_capacity() const -> size_type;
+    auto max_retained_bytes() const -> size_type;
+    void set_max_retained_bytes(size_type n_bytes);
 
     // Allocation
     auto allocate(size_type n_bytes, size_type alignment) -> void*;
     auto deallocate(void* ptr, size_type n_bytes, size_type alignment) -> void;
     // If there is room in the active pool then extend the allocation
     // otherwise create a new pool and allocate from it
+    // Shrinking the most recent allocation gives the freed tail back to the pool
     auto extend(void* ptr, size_type old_bytes, size_type new_bytes, size_type alignment) -> void*;
+
+    // Rewinding
+    // Discards every allocation but keeps the pools, up to max_retained_bytes
+    void reset();
+    auto mark() const -> arena_mmr_mark;
+    // Discards every allocation made since m was taken
+    void rewind(arena_mmr_mark m);
+
+    // Growth
+    // Makes and pre-faults the next pool now unless one is already waiting
+    void prepare_next_pool();
+    // As above but on a helper thread, the pool is picked up when the active one runs out
+    void prepare_next_pool_async();
+    // Whether a pool is waiting after the active one or being prepared
+    auto next_pool_ready() const -> bool;
   private:
+    // Handles everything the inline fast path doesn't
+    auto allocate_slow(size_type n_bytes, size_type alignment) -> void*;
+    // Moves to the next kept pool or creates one
+    void advance_pool(size_type n_bytes, size_type alignment);
+    auto next_pool_size(size_type previous_capacity, size_type bytes_needed) const -> size_type;
+    auto allocate_dedicated(size_type n_bytes, size_type alignment) -> void*;
+    // Frees dedicated pools until last is at the front
+    void release_dedicated_until(arena_mmr_pool* last);
+    void release_pools_after(arena_mmr_pool* pool);
+    static void destroy_pool(arena_mmr_pool* pool);
+    auto prepared_pool_size() const -> size_type;
+    // Splices a prepared pool in after the active one
+    void adopt_pool(arena_mmr_pool* pool);
+    // Waits for any pool being prepared on a helper thread
+    void collect_pending_pool();
+
     arena_mmr_pool* pool_{nullptr};
     arena_mmr_pool* last_pool_{nullptr};
     size_type initial_capacity_{1024};
+    size_type max_retained_bytes_{retain_all};
+    arena_growth_policy policy_{};
+    // Pools holding a single large allocation, most recent first
+    arena_mmr_pool* dedicated_{nullptr};
+    size_type dedicated_size_{0};
+    // Cached so the capacity queries don't walk the pool list
+    size_type n_pools_{0};
+    size_type total_capacity_{0};
+    size_type prior_size_{0};
+    std::future<arena_mmr_pool*> pending_pool_;
 };
 
 // Ctor
 inline arena_mmr::~arena_mmr() {
+    if (pending_pool_.valid()) {
+        try {
+            destroy_pool(pending_pool_.get());
+        } catch (...) {
+        }
+    }
     if (pool_) {
-        pool_->~arena_mmr_pool();
-        delete[] reinterpret_cast<std::byte*>(pool_);
+        destroy_pool(pool_);
+    }
+    if (dedicated_) {
+        destroy_pool(dedicated_);
     }
 }
 // Access
 inline auto arena_mmr::pool() const -> arena_mmr_pool const* {
     return pool_;
 }
+inline auto arena_mmr::policy() const -> arena_growth_policy const& {
+    return policy_;
+}
 // Capacity
 inline auto arena_mmr::initial_capacity() const -> size_type {
     return initial_capacity_;
 }
 inline auto arena_mmr::n_pools() const -> size_type {
-    size_type count{0};
-    for (auto const* p{pool()}; p; p = p->next_pool()) {
-        ++count;
-    }
-    return count;
+    return n_pools_;
 }
 inline auto arena_mmr::total_size() const -> size_type {
-    size_type total{0};
-    for (auto const* p{pool()}; p; p = p->next_pool()) {
-        total += p->size();
-    }
-    return total;
+    // Pools after the active one are kept for reuse and hold nothing
+    return (last_pool_ ? prior_size_ + last_pool_->size() : 0) + dedicated_size_;
+}
+inline auto arena_mmr::total_capacity() const -> size_type {
+    return total_capacity_;
+}
+inline auto arena_mmr::max_retained_bytes() const -> size_type {
+    return max_retained_bytes_;
+}
+inline void arena_mmr::set_max_retained_bytes(size_type n_bytes) {
+    max_retained_bytes_ = n_bytes;
 }
 // Allocation
+inline auto arena_mmr::allocate(size_type n_bytes, size_type alignment) -> void* {
+    // A bump in the active pool when no policy needs checking
+    if (last_pool_ && n_bytes < policy_.dedicated_threshold && policy_.prepare_high_water >= 1.0) {
+        if (auto* ptr{last_pool_->try_allocate(n_bytes, alignment)}) {
+            return ptr;
+        }
+    }
+    return allocate_slow(n_bytes, alignment);
+}
 inline auto arena_mmr::deallocate(void* ptr, size_type n_bytes, size_type alignment) -> void {
     if (pool_) {
         pool_->deallocate(ptr, n_bytes, alignment);
@@ -80,14 +195,18 @@ inline auto arena_mmr::extend(void* ptr, size_type old_bytes, size_type new_byte
         return allocate(new_bytes, alignment);
     }
 
-    if (new_bytes <= old_bytes) {
-        return ptr;
-    }
-
     auto* const pool{last_pool_};
     auto* const pool_cur_pos{pool->next_alloc_start()};
     auto const pool_size{pool->size()};
 
+    if (new_bytes <= old_bytes) {
+        // The tail of the most recent allocation can be handed out again
+        if (old_bytes <= pool_size && pool_cur_pos - old_bytes == ptr) {
+            pool->rewind_to(pool_size - (old_bytes - new_bytes));
+        }
+        return ptr;
+    }
+
     // Do a size check to see if the allocation could have been made in the current pool
     if (old_bytes > pool_size) {
         return allocate(new_bytes, alignment);
@@ -100,7 +219,36 @@ inline auto arena_mmr::extend(void* ptr, size_type old_bytes, size_type new_byte
     }
 
     auto const alloc_diff{new_bytes - old_bytes};
+    if (alloc_diff > pool->remaining_capacity()) {
+        return allocate(new_bytes, alignment);
+    }
+
     pool->extend_by(alloc_diff);
     return ptr;
 }
+// Growth
+inline auto arena_mmr::next_pool_ready() const -> bool {
+    return pending_pool_.valid() || (last_pool_ && last_pool_->next_pool_);
+}
+// Rewinding
+inline auto arena_mmr::mark() const -> arena_mmr_mark {
+    if (!last_pool_) {
+        return {nullptr, 0, 0, dedicated_, dedicated_size_};
+    }
+    return {last_pool_, last_pool_->size(), prior_size_, dedicated_, dedicated_size_};
+}
+inline void arena_mmr::rewind(arena_mmr_mark m) {
+    release_dedicated_until(m.dedicated);
+    dedicated_size_ = m.dedicated_size;
+
+    if (m.pool) {
+        last_pool_ = m.pool;
+        last_pool_->rewind_to(m.size);
+        prior_size_ = m.prior_size;
+    } else if (pool_) {
+        last_pool_ = pool_;
+        last_pool_->rewind_to(0);
+        prior_size_ = 0;
+    }
+}
 }
@@ -26,11 +26,17 @@ class arena_mmr_pool {
     auto total_capacity() const -> std::size_t;
     auto remaining_capacity() const -> std::size_t;
     auto size() const -> std::size_t;
+    // Checks if an allocation fits including its alignment padding
+    auto can_allocate(std::size_t n_bytes, std::size_t alignment) -> bool;
 
     // Allocation
     [[nodiscard]] auto allocate(std::size_t n_bytes, std::size_t alignment) -> void*;
+    // Returns nullptr rather than throwing if the allocation doesn't fit
+    [[nodiscard]] auto try_allocate(std::size_t n_bytes, std::size_t alignment) -> void*;
     void deallocate(void* alloc, std::size_t n_bytes, std::size_t alignment);
     void extend_by(std::size_t n_bytes);
+    // Discards every allocation made after the pool reached new_size
+    void rewind_to(std::size_t new_size);
   private:
     arena_mmr_pool* next_pool_{nullptr};
     std::size_t total_capacity_{0};
@@ -70,6 +76,11 @@ inline auto arena_mmr_pool::remaining_capacity() const -> std::size_t {
 inline auto arena_mmr_pool::size() const -> std::size_t {
     return total_capacity_ - remaining_capacity_;
 }
+inline auto arena_mmr_pool::can_allocate(std::size_t n_bytes, std::size_t alignment) -> bool {
+    auto* start{static_cast<void*>(next_alloc_start())};
+    auto remaining{remaining_capacity_};
+    return std::align(alignment, n_bytes, start, remaining) != nullptr;
+}
 // Allocation
 inline auto arena_mmr_pool::create_pool(std::size_t initial_size) -> arena_mmr_pool* {
     std::size_t const bytes_needed{initial_size + sizeof(arena_mmr_pool)};
@@ -86,6 +97,16 @@ inline auto arena_mmr_pool::allocate(std::size_t n_bytes, std::size_t alignment)
     remaining_capacity_ -= n_bytes;
     return new_start;
 }
+inline auto arena_mmr_pool::try_allocate(std::size_t n_bytes, std::size_t alignment) -> void* {
+    auto* new_start{static_cast<void*>(next_alloc_start())};
+
+    if (!std::align(alignment, n_bytes, new_start, remaining_capacity_)) {
+        return nullptr;
+    }
+
+    remaining_capacity_ -= n_bytes;
+    return new_start;
+}
 inline void arena_mmr_pool::deallocate(void* /*alloc*/, std::size_t /*n_bytes*/, std::size_t /*alignment*/) {
     // no-op
     return;
@@ -93,4 +114,7 @@ inline void arena_mmr_pool::deallocate(void* /*alloc*/, std::size_t /*n_bytes*/,
 inline void arena_mmr_pool::extend_by(std::size_t n_bytes) {
     remaining_capacity_ -= n_bytes;
 }
+inline void arena_mmr_pool::rewind_to(std::size_t new_size) {
+    remaining_capacity_ = total_capacity_ - new_size;
+}
 }
@@ -4,12 +4,24 @@
 #include <memory_resource>
 
 #include "arena_mmr.hpp"
+#include "pmr.hpp"
+#include "resource_mixins.hpp"
 
 namespace ml {
-class arena_pmr : public std::pmr::memory_resource {
+/*
+Arena usable as both a std::pmr::memory_resource and an ml::pmr.
+std::pmr containers and vector2 can share the same arena, the latter keeps its in-place extend.
+*/
+class arena_pmr : public pmr_mixins::dual_pmr<arena_pmr> {
+    friend class pmr_mixins::dual_pmr<arena_pmr>;
   public:
+    using size_type = std::size_t;
+
     arena_pmr() = default;
-    explicit arena_pmr(std::size_t initial_capacity);
+    explicit arena_pmr(std::size_t initial_capacity, std::size_t max_retained_bytes = arena_mmr::retain_all);
+    arena_pmr(std::size_t initial_capacity,
+              arena_growth_policy const& policy,
+              std::size_t max_retained_bytes = arena_mmr::retain_all);
     ~arena_pmr() override = default;
 
     arena_pmr(arena_pmr const&) = delete;
@@ -17,25 +29,69 @@ class arena_pmr : public std::pmr::memory_resource {
 
     auto operator=(arena_pmr const&) -> arena_pmr& = delete;
     auto operator=(arena_pmr&& other) noexcept -> arena_pmr& = default;
+
+    // Access
+    auto arena() const -> arena_mmr const&;
+
+    // Rewinding
+    void reset();
+    auto mark() const -> arena_mmr_mark;
+    void rewind(arena_mmr_mark m);
+
+    // Growth
+    void prepare_next_pool();
+    void prepare_next_pool_async();
+    auto next_pool_ready() const -> bool;
   protected:
+    // Overrides the functions of both bases
     auto do_allocate(std::size_t n_bytes, std::size_t alignment) -> void* override final;
     void do_deallocate(void* p, std::size_t n_bytes, std::size_t alignment) override final;
-    auto do_is_equal(std::pmr::memory_resource const& other) const noexcept -> bool override final;
+    auto do_extend(void* ptr, std::size_t old_bytes, std::size_t new_bytes, std::size_t alignment)
+        -> void* override final;
   private:
-    arena_mmr arena;
+    arena_mmr arena_;
 };
 
 // Ctor
-inline arena_pmr::arena_pmr(std::size_t initial_capacity)
-    : arena{initial_capacity} {}
+inline arena_pmr::arena_pmr(std::size_t initial_capacity, std::size_t max_retained_bytes)
+    : arena_{initial_capacity, max_retained_bytes} {}
+inline arena_pmr::arena_pmr(std::size_t initial_capacity,
+                            arena_growth_policy const& policy,
+                            std::size_t max_retained_bytes)
+    : arena_{initial_capacity, policy, max_retained_bytes} {}
+// Access
+inline auto arena_pmr::arena() const -> arena_mmr const& {
+    return arena_;
+}
+// Rewinding
+inline void arena_pmr::reset() {
+    arena_.reset();
+}
+inline auto arena_pmr::mark() const -> arena_mmr_mark {
+    return arena_.mark();
+}
+inline void arena_pmr::rewind(arena_mmr_mark m) {
+    arena_.rewind(m);
+}
+// Growth
+inline void arena_pmr::prepare_next_pool() {
+    arena_.prepare_next_pool();
+}
+inline void arena_pmr::prepare_next_pool_async() {
+    arena_.prepare_next_pool_async();
+}
+inline auto arena_pmr::next_pool_ready() const -> bool {
+    return arena_.next_pool_ready();
+}
 // Methods
 inline auto arena_pmr::do_allocate(std::size_t n_bytes, std::size_t alignment) -> void* {
-    return arena.allocate(n_bytes, alignment);
+    return arena_.allocate(n_bytes, alignment);
 }
 inline void arena_pmr::do_deallocate(void* p, std::size_t n_bytes, std::size_t alignment) {
-    return arena.deallocate(p, n_bytes, alignment);
+    return arena_.deallocate(p, n_bytes, alignment);
 }
-inline auto arena_pmr::do_is_equal(std::pmr::memory_resource const& other) const noexcept -> bool {
-    return this == &other;
+inline auto arena_pmr::do_extend(void* ptr, std::size_t old_bytes, std::size_t new_bytes, std::size_t alignment)
+    -> void* {
+    return arena_.extend(ptr, old_bytes, new_bytes, alignment);
 }
 }
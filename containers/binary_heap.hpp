@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstddef>
+#include <iterator>
 #include <memory_resource>
 #include <utility>
 #include <vector>
@@ -25,7 +26,8 @@ class binary_heap {
 
     binary_heap() noexcept = default;
     binary_heap(Allocator const& alloc) noexcept
-        : allocator_{alloc} {}
+        : allocator_{alloc}
+        , data_{alloc} {}
 
     // Access
     template <typename Self>
@@ -52,6 +54,11 @@ class binary_heap {
     auto empty() const noexcept -> bool { return data_.empty(); }
     auto reserve(size_type n) -> void { data_.reserve(n); }
     auto size() const noexcept -> size_type { return data_.size(); }
+    // Moves the elements into a new allocation which fits them exactly
+    void compact() {
+        data_ = std::vector<T, Allocator>(
+            std::make_move_iterator(data_.begin()), std::make_move_iterator(data_.end()), allocator_);
+    }
 
     // Modifiers
     void clear() noexcept { data_.clear(); }
@@ -35,6 +35,10 @@ class bst {
             , child{child_} {}
     };
 
+    // Ctor
+    bst() = default;
+    explicit bst(allocator_type const& alloc);
+
     // Access
     template <typename U>
         requires detail::bst_can_be_compared<T, U, Compare>
@@ -94,6 +98,11 @@ class bst {
     __VA_OPT__(__VA_ARGS__)                                                         \
     inline auto bst<T, Compare, Allocator>
 
+// Ctor
+template <typename T, typename Compare, template <typename> typename Allocator>
+inline bst<T, Compare, Allocator>::bst(allocator_type const& alloc)
+    : alloc_{alloc} {}
+
 // Access
 template <typename T, typename Compare, template <typename> typename Allocator>
 template <typename U>
@@ -2,37 +2,82 @@
 
 #include <array>
 #include <cstddef>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <new>
 
 #include "mmr_allocator.hpp"
 
 namespace ml {
+/*
+Bump resource over an inline buffer.
+
+Without an upstream a request which doesn't fit throws std::bad_alloc.
+With an upstream it is passed on instead, so the buffer covers the common case
+and the upstream takes the overflow.
+*/
 template <std::size_t CAPACITY>
 class buffer_mmr {
   public:
     using size_type = std::size_t;
 
     buffer_mmr() = default;
+    explicit buffer_mmr(std::pmr::memory_resource* upstream)
+        : upstream_{upstream} {}
+
+    // Access
+    auto upstream() const -> std::pmr::memory_resource* { return upstream_; }
+    // Checks if ptr points into the inline buffer
+    auto owns(void const* ptr) const -> bool {
+        auto const* p{static_cast<std::byte const*>(ptr)};
+        return std::greater_equal<>{}(p, buffer.data()) && std::less<>{}(p, buffer.data() + CAPACITY);
+    }
 
     // Allocation
     [[nodiscard]] auto allocate(size_type n_bytes, size_type alignment) -> void* {
         auto const cur_size{CAPACITY - remaining_capacity_};
 
         auto* new_start{static_cast<void*>(buffer.data() + cur_size)};
-        if (!std::align(alignment, n_bytes, new_start, remaining_capacity_)) {
+        auto remaining{remaining_capacity_};
+        if (!std::align(alignment, n_bytes, new_start, remaining)) {
+            if (upstream_) {
+                return upstream_->allocate(n_bytes, alignment);
+            }
             throw std::bad_alloc{};
         }
 
-        remaining_capacity_ -= n_bytes;
+        remaining_capacity_ = remaining - n_bytes;
         this->last_allocation_ = new_start;
         return this->last_allocation_;
     }
-    void deallocate(void* /*alloc*/, size_type /*n_bytes*/, size_type /*alignment*/) { return; }
+    void deallocate(void* ptr, size_type n_bytes, size_type alignment) {
+        if (upstream_ && ptr && !owns(ptr)) {
+            upstream_->deallocate(ptr, n_bytes, alignment);
+        }
+    }
+    /*
+    Shrinking the most recent allocation gives the freed tail back to the buffer.
+    Upstream blocks are never shrunk in place, as the upstream must get the original size back,
+    so shrinking one allocates a new block which the caller moves into.
+    */
     auto extend(void* ptr, size_type old_bytes, size_type new_bytes, size_type alignment) -> void* {
-        auto const extension_size{new_bytes - old_bytes};
-
-        assert(new_bytes > old_bytes);
+        if (new_bytes <= old_bytes) {
+            if (ptr && !owns(ptr)) {
+                return upstream_->allocate(new_bytes, alignment);
+            }
+            if (ptr && ptr == last_allocation_) {
+                remaining_capacity_ += old_bytes - new_bytes;
+            }
+            return ptr;
+        }
 
+        auto const extension_size{new_bytes - old_bytes};
         if (extension_size > remaining_capacity_) {
+            if (upstream_) {
+                // The caller moves the elements and deallocates the old block
+                return upstream_->allocate(new_bytes, alignment);
+            }
             throw std::bad_alloc{};
         }
 
@@ -54,6 +99,7 @@ class buffer_mmr {
     std::array<std::byte, CAPACITY> buffer;
     size_type remaining_capacity_{CAPACITY};
     void* last_allocation_{nullptr};
+    std::pmr::memory_resource* upstream_{nullptr};
 };
 
 template <typename T, std::size_t CAPACITY>
@@ -15,6 +15,9 @@ class buffer_pmr : public resource_base {
     using size_type = std::size_t;
 
     buffer_pmr() = default;
+    // Requests which don't fit the buffer go to upstream instead of throwing
+    explicit buffer_pmr(std::pmr::memory_resource* upstream)
+        : buffer_resource_{upstream} {}
     ~buffer_pmr() override = default;
 
     auto do_allocate(size_type n_bytes, size_type alignment) -> void* override final {
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+#include "arena_pmr.hpp"
+#include "pmr.hpp"
+#include "resource_mixins.hpp"
+
+namespace ml {
+// Containers which can move their elements into a fresh, tightly sized allocation
+template <typename T>
+concept compactable = requires(T t) {
+    { t.compact() };
+};
+
+/*
+Arena which can reclaim the dead space left by deallocations.
+
+Containers using this resource are registered with track().
+compact() switches to a fresh arena, has every tracked container move its elements into it
+and then releases the old pools. The containers keep pointing at this resource so nothing needs rewiring.
+Pointers into the old storage are invalidated, as are allocations not owned by a tracked container.
+Containers must be untracked before they are destroyed.
+If a container's compact() throws, the ones not yet compacted still point into the old arena,
+so it is kept alive until the next successful compaction or the resource's destruction.
+*/
+class compacting_arena_pmr : public pmr_mixins::dual_pmr<compacting_arena_pmr> {
+    friend class pmr_mixins::dual_pmr<compacting_arena_pmr>;
+  public:
+    using size_type = std::size_t;
+
+    compacting_arena_pmr() = default;
+    explicit compacting_arena_pmr(size_type initial_capacity, arena_growth_policy const& policy = {});
+    ~compacting_arena_pmr() override = default;
+
+    // Containers point at the resource so it can't be moved
+    compacting_arena_pmr(compacting_arena_pmr const&) = delete;
+    compacting_arena_pmr(compacting_arena_pmr&&) = delete;
+
+    auto operator=(compacting_arena_pmr const&) -> compacting_arena_pmr& = delete;
+    auto operator=(compacting_arena_pmr&&) -> compacting_arena_pmr& = delete;
+
+    // Access
+    auto arena() const -> arena_mmr const& { return arena_.arena(); }
+    auto n_tracked() const -> size_type { return tracked_.size(); }
+
+    // Compaction
+    template <compactable Container>
+    void track(Container& container);
+    template <compactable Container>
+    void untrack(Container& container);
+    // Returns the number of bytes of capacity released
+    auto compact() -> size_type;
+  protected:
+    auto do_allocate(std::size_t n_bytes, std::size_t alignment) -> void* override final {
+        return arena_.allocate(n_bytes, alignment);
+    }
+    void do_deallocate(void* ptr, std::size_t n_bytes, std::size_t alignment) override final {
+        arena_.deallocate(ptr, n_bytes, alignment);
+    }
+    auto do_extend(void* ptr, std::size_t old_bytes, std::size_t new_bytes, std::size_t alignment)
+        -> void* override final {
+        return arena_.extend(ptr, old_bytes, new_bytes, alignment);
+    }
+  private:
+    struct tracked_container {
+        void* container{nullptr};
+        void (*compact)(void*){nullptr};
+    };
+
+    arena_pmr arena_{};
+    // Arenas left behind by a compaction which threw, some containers may still point into them
+    std::vector<arena_pmr> retained_;
+    size_type initial_capacity_{1024};
+    arena_growth_policy policy_{};
+    std::vector<tracked_container> tracked_;
+};
+
+// Ctor
+inline compacting_arena_pmr::compacting_arena_pmr(size_type initial_capacity, arena_growth_policy const& policy)
+    : arena_{initial_capacity, policy}
+    , initial_capacity_{initial_capacity}
+    , policy_{policy} {}
+// Compaction
+template <compactable Container>
+inline void compacting_arena_pmr::track(Container& container) {
+    tracked_.push_back({&container, [](void* c) { static_cast<Container*>(c)->compact(); }});
+}
+template <compactable Container>
+inline void compacting_arena_pmr::untrack(Container& container) {
+    std::erase_if(tracked_, [&container](tracked_container const& t) { return t.container == &container; });
+}
+inline auto compacting_arena_pmr::compact() -> size_type {
+    auto const old_capacity{arena_.arena().total_capacity()};
+
+    // New allocations go to the fresh arena while the old one stays alive for the elements to be moved out of
+    arena_pmr old_arena{std::move(arena_)};
+    arena_ = arena_pmr{initial_capacity_, policy_};
+    try {
+        for (auto const& t : tracked_) {
+            t.compact(t.container);
+        }
+    } catch (...) {
+        retained_.push_back(std::move(old_arena));
+        throw;
+    }
+    // Every tracked container has moved out of the arenas kept by earlier failures
+    retained_.clear();
+
+    auto const new_capacity{arena_.arena().total_capacity()};
+    return old_capacity > new_capacity ? old_capacity - new_capacity : 0;
+}
+}
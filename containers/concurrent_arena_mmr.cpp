@@ -0,0 +1,50 @@
+#include "concurrent_arena_mmr.hpp"
+#include "misc.hpp"
+
+namespace ml {
+concurrent_arena_mmr::concurrent_arena_mmr(size_type initial_capacity)
+    : initial_capacity_{initial_capacity} {}
+
+auto concurrent_arena_mmr::install_next_pool(concurrent_arena_mmr_pool* current,
+                                             size_type n_bytes,
+                                             size_type alignment) -> concurrent_arena_mmr_pool* {
+    // Leave room for the worst-case alignment padding so the request always fits
+    auto const bytes_needed{n_bytes + alignment};
+    auto make_new_size{[](auto cap, auto n_b) { return ml::max(cap, (n_b / cap) * size_type{2} * cap); }};
+
+    // The first pool is installed as the head
+    if (!current) {
+        auto* head{pool_.load(std::memory_order_acquire)};
+        if (!head) {
+            auto* fresh{concurrent_arena_mmr_pool::create_pool(make_new_size(initial_capacity_, bytes_needed))};
+            if (pool_.compare_exchange_strong(head, fresh, std::memory_order_acq_rel, std::memory_order_acquire)) {
+                head = fresh;
+            } else {
+                concurrent_arena_mmr_pool::destroy_pool(fresh);
+            }
+        }
+
+        concurrent_arena_mmr_pool* expected{nullptr};
+        last_pool_.compare_exchange_strong(expected, head, std::memory_order_acq_rel, std::memory_order_acquire);
+        return head;
+    }
+
+    auto* next{current->next_pool_.load(std::memory_order_acquire)};
+    if (!next) {
+        auto const cap{current->total_capacity()};
+        auto* fresh{concurrent_arena_mmr_pool::create_pool(make_new_size(cap, bytes_needed))};
+        if (current->next_pool_.compare_exchange_strong(
+                next, fresh, std::memory_order_acq_rel, std::memory_order_acquire)) {
+            next = fresh;
+        } else {
+            // Another thread linked a pool first so use theirs
+            concurrent_arena_mmr_pool::destroy_pool(fresh);
+        }
+    }
+
+    // Only advance if no other thread has already moved past current
+    auto* expected{current};
+    last_pool_.compare_exchange_strong(expected, next, std::memory_order_acq_rel, std::memory_order_acquire);
+    return next;
+}
+}
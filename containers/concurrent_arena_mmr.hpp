@@ -0,0 +1,116 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+#include "concurrent_arena_mmr_pool.hpp"
+#include "misc.hpp"
+#include "mmr_allocator.hpp"
+
+namespace ml {
+// Thread-safe arena
+// Allocation is a CAS on the active pool's bump offset
+// When the active pool is full the next pool is installed with a CAS on its predecessor's link
+// so threads racing to grow the arena agree on a single successor
+class concurrent_arena_mmr {
+  public:
+    using size_type = std::size_t;
+
+    concurrent_arena_mmr() = default;
+    explicit concurrent_arena_mmr(size_type initial_capacity);
+    ~concurrent_arena_mmr();
+
+    // Threads hold pointers to the arena so it can't be moved
+    concurrent_arena_mmr(concurrent_arena_mmr const&) = delete;
+    concurrent_arena_mmr(concurrent_arena_mmr&&) = delete;
+
+    auto operator=(concurrent_arena_mmr const&) -> concurrent_arena_mmr& = delete;
+    auto operator=(concurrent_arena_mmr&&) -> concurrent_arena_mmr& = delete;
+
+    // Access
+    auto pool() const -> concurrent_arena_mmr_pool const*;
+
+    // Capacity
+    auto initial_capacity() const -> size_type;
+    auto n_pools() const -> size_type;
+    auto total_size() const -> size_type;
+
+    // Allocation
+    [[nodiscard]] auto allocate(size_type n_bytes, size_type alignment) -> void*;
+    auto deallocate(void* ptr, size_type n_bytes, size_type alignment) -> void;
+    // Extends in place if ptr is the most recent allocation in the active pool
+    // otherwise makes a fresh allocation which the caller must copy into
+    [[nodiscard]] auto extend(void* ptr, size_type old_bytes, size_type new_bytes, size_type alignment)
+        -> void*;
+  private:
+    // Returns the pool after current, creating it if no other thread has yet
+    auto install_next_pool(concurrent_arena_mmr_pool* current, size_type n_bytes, size_type alignment)
+        -> concurrent_arena_mmr_pool*;
+
+    std::atomic<concurrent_arena_mmr_pool*> pool_{nullptr};
+    size_type initial_capacity_{1024};
+    alignas(cache_line_size) std::atomic<concurrent_arena_mmr_pool*> last_pool_{nullptr};
+};
+
+// Ctor
+inline concurrent_arena_mmr::~concurrent_arena_mmr() {
+    if (auto* head{pool_.load(std::memory_order_acquire)}) {
+        concurrent_arena_mmr_pool::destroy_pool(head);
+    }
+}
+// Access
+inline auto concurrent_arena_mmr::pool() const -> concurrent_arena_mmr_pool const* {
+    return pool_.load(std::memory_order_acquire);
+}
+// Capacity
+inline auto concurrent_arena_mmr::initial_capacity() const -> size_type {
+    return initial_capacity_;
+}
+inline auto concurrent_arena_mmr::n_pools() const -> size_type {
+    size_type count{0};
+    for (auto const* p{pool()}; p; p = p->next_pool()) {
+        ++count;
+    }
+    return count;
+}
+inline auto concurrent_arena_mmr::total_size() const -> size_type {
+    size_type total{0};
+    for (auto const* p{pool()}; p; p = p->next_pool()) {
+        total += p->size();
+    }
+    return total;
+}
+// Allocation
+inline auto concurrent_arena_mmr::allocate(size_type n_bytes, size_type alignment) -> void* {
+    auto* pool{last_pool_.load(std::memory_order_acquire)};
+    while (true) {
+        if (pool) {
+            if (auto* ptr{pool->allocate(n_bytes, alignment)}) {
+                return ptr;
+            }
+        }
+        pool = install_next_pool(pool, n_bytes, alignment);
+    }
+}
+inline auto concurrent_arena_mmr::deallocate(void* /*ptr*/, size_type /*n_bytes*/, size_type /*alignment*/)
+    -> void {
+    // no-op
+    return;
+}
+inline auto concurrent_arena_mmr::extend(void* ptr, size_type old_bytes, size_type new_bytes, size_type alignment)
+    -> void* {
+    if (!ptr) {
+        return allocate(new_bytes, alignment);
+    }
+    if (new_bytes <= old_bytes) {
+        return ptr;
+    }
+
+    if (auto* pool{last_pool_.load(std::memory_order_acquire)}) {
+        if (auto* extended{pool->extend(ptr, old_bytes, new_bytes)}) {
+            return extended;
+        }
+    }
+    return allocate(new_bytes, alignment);
+}
+}
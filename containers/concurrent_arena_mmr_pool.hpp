@@ -0,0 +1,140 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+#include "misc.hpp"
+
+namespace ml {
+class concurrent_arena_mmr;
+
+// Arena pool which can be bumped from several threads at once
+// The bump offset is advanced with a CAS so allocations never take a lock
+class concurrent_arena_mmr_pool {
+  public:
+    explicit concurrent_arena_mmr_pool(std::size_t capacity);
+    ~concurrent_arena_mmr_pool();
+
+    concurrent_arena_mmr_pool(concurrent_arena_mmr_pool const&) = delete;
+    concurrent_arena_mmr_pool(concurrent_arena_mmr_pool&&) = delete;
+
+    auto operator=(concurrent_arena_mmr_pool const&) -> concurrent_arena_mmr_pool& = delete;
+    auto operator=(concurrent_arena_mmr_pool&&) -> concurrent_arena_mmr_pool& = delete;
+
+    friend class concurrent_arena_mmr;
+
+    static auto create_pool(std::size_t initial_size) -> concurrent_arena_mmr_pool*;
+    static void destroy_pool(concurrent_arena_mmr_pool* pool);
+
+    // Access
+    auto next_pool() const -> concurrent_arena_mmr_pool const*;
+    auto data() -> std::byte*;
+    // Points to the address after the last byte of the pool
+    auto data_end() -> std::byte*;
+    auto owns(void const* ptr) -> bool;
+
+    // Capacity
+    auto total_capacity() const -> std::size_t;
+    auto remaining_capacity() const -> std::size_t;
+    auto size() const -> std::size_t;
+
+    // Allocation
+    // Both return nullptr instead of throwing when the pool is out of room
+    [[nodiscard]] auto allocate(std::size_t n_bytes, std::size_t alignment) -> void*;
+    [[nodiscard]] auto extend(void* ptr, std::size_t old_bytes, std::size_t new_bytes) -> void*;
+  private:
+    std::atomic<concurrent_arena_mmr_pool*> next_pool_{nullptr};
+    std::size_t total_capacity_{0};
+    // Every allocating thread hits this so keep it off the read-mostly line
+    alignas(cache_line_size) std::atomic<std::size_t> size_{0};
+};
+
+// Ctor
+inline concurrent_arena_mmr_pool::concurrent_arena_mmr_pool(std::size_t capacity)
+    : total_capacity_{capacity} {}
+inline concurrent_arena_mmr_pool::~concurrent_arena_mmr_pool() {
+    if (auto* next{next_pool_.load(std::memory_order_acquire)}) {
+        destroy_pool(next);
+    }
+}
+// Access
+inline auto concurrent_arena_mmr_pool::next_pool() const -> concurrent_arena_mmr_pool const* {
+    return next_pool_.load(std::memory_order_acquire);
+}
+inline auto concurrent_arena_mmr_pool::data() -> std::byte* {
+    return static_cast<std::byte*>(static_cast<void*>(this)) + sizeof(concurrent_arena_mmr_pool);
+}
+inline auto concurrent_arena_mmr_pool::data_end() -> std::byte* {
+    return data() + total_capacity_;
+}
+inline auto concurrent_arena_mmr_pool::owns(void const* ptr) -> bool {
+    auto const* p{static_cast<std::byte const*>(ptr)};
+    return (p >= data()) && (p < data_end());
+}
+// Capacity
+inline auto concurrent_arena_mmr_pool::total_capacity() const -> std::size_t {
+    return total_capacity_;
+}
+inline auto concurrent_arena_mmr_pool::remaining_capacity() const -> std::size_t {
+    return total_capacity_ - size();
+}
+inline auto concurrent_arena_mmr_pool::size() const -> std::size_t {
+    return size_.load(std::memory_order_relaxed);
+}
+// Allocation
+inline auto concurrent_arena_mmr_pool::create_pool(std::size_t initial_size)
+    -> concurrent_arena_mmr_pool* {
+    static constexpr std::align_val_t pool_alignment{alignof(concurrent_arena_mmr_pool)};
+
+    std::size_t const bytes_needed{initial_size + sizeof(concurrent_arena_mmr_pool)};
+    auto* buffer{::operator new(bytes_needed, pool_alignment)};
+    return new (buffer) concurrent_arena_mmr_pool(initial_size);
+}
+inline void concurrent_arena_mmr_pool::destroy_pool(concurrent_arena_mmr_pool* pool) {
+    static constexpr std::align_val_t pool_alignment{alignof(concurrent_arena_mmr_pool)};
+
+    auto const bytes{pool->total_capacity_ + sizeof(concurrent_arena_mmr_pool)};
+    pool->~concurrent_arena_mmr_pool();
+    ::operator delete(static_cast<void*>(pool), bytes, pool_alignment);
+}
+inline auto concurrent_arena_mmr_pool::allocate(std::size_t n_bytes, std::size_t alignment)
+    -> void* {
+    auto const base{reinterpret_cast<std::uintptr_t>(data())};
+    auto cur{size_.load(std::memory_order_relaxed)};
+
+    while (true) {
+        auto const start{base + cur};
+        auto const padding{(alignment - (start % alignment)) % alignment};
+        auto const new_size{cur + padding + n_bytes};
+
+        if (new_size > total_capacity_) {
+            return nullptr;
+        }
+        // The memory itself isn't published through size_ so relaxed ordering is enough
+        if (size_.compare_exchange_weak(cur, new_size, std::memory_order_relaxed)) {
+            return data() + cur + padding;
+        }
+    }
+}
+inline auto concurrent_arena_mmr_pool::extend(void* ptr, std::size_t old_bytes, std::size_t new_bytes)
+    -> void* {
+    if (!owns(ptr)) {
+        return nullptr;
+    }
+
+    auto const offset{static_cast<std::size_t>(static_cast<std::byte*>(ptr) - data())};
+    auto const new_size{offset + new_bytes};
+    if (new_size > total_capacity_) {
+        return nullptr;
+    }
+
+    // Only succeeds if no other allocation has been made after ptr
+    auto expected{offset + old_bytes};
+    if (size_.compare_exchange_strong(expected, new_size, std::memory_order_relaxed)) {
+        return ptr;
+    }
+    return nullptr;
+}
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+
+#include "concurrent_arena_mmr.hpp"
+#include "pmr.hpp"
+#include "resource_mixins.hpp"
+
+namespace ml {
+// Usable as both a std::pmr::memory_resource and an ml::pmr, see arena_pmr
+class concurrent_arena_pmr : public pmr_mixins::dual_pmr<concurrent_arena_pmr> {
+    friend class pmr_mixins::dual_pmr<concurrent_arena_pmr>;
+  public:
+    using size_type = std::size_t;
+
+    concurrent_arena_pmr() = default;
+    explicit concurrent_arena_pmr(std::size_t initial_capacity);
+    ~concurrent_arena_pmr() override = default;
+
+    concurrent_arena_pmr(concurrent_arena_pmr const&) = delete;
+    concurrent_arena_pmr(concurrent_arena_pmr&& other) = delete;
+
+    auto operator=(concurrent_arena_pmr const&) -> concurrent_arena_pmr& = delete;
+    auto operator=(concurrent_arena_pmr&& other) -> concurrent_arena_pmr& = delete;
+
+    // Access
+    auto arena() const -> concurrent_arena_mmr const&;
+
+  protected:
+    auto do_allocate(std::size_t n_bytes, std::size_t alignment) -> void* override final;
+    void do_deallocate(void* p, std::size_t n_bytes, std::size_t alignment) override final;
+    auto do_extend(void* ptr, std::size_t old_bytes, std::size_t new_bytes, std::size_t alignment)
+        -> void* override final;
+  private:
+    concurrent_arena_mmr arena_;
+};
+
+// Ctor
+inline concurrent_arena_pmr::concurrent_arena_pmr(std::size_t initial_capacity)
+    : arena_{initial_capacity} {}
+// Access
+inline auto concurrent_arena_pmr::arena() const -> concurrent_arena_mmr const& {
+    return arena_;
+}
+// Methods
+inline auto concurrent_arena_pmr::do_allocate(std::size_t n_bytes, std::size_t alignment) -> void* {
+    return arena_.allocate(n_bytes, alignment);
+}
+inline void concurrent_arena_pmr::do_deallocate(void* p, std::size_t n_bytes, std::size_t alignment) {
+    return arena_.deallocate(p, n_bytes, alignment);
+}
+inline auto concurrent_arena_pmr::do_extend(void* ptr,
+                                            std::size_t old_bytes,
+                                            std::size_t new_bytes,
+                                            std::size_t alignment) -> void* {
+    return arena_.extend(ptr, old_bytes, new_bytes, alignment);
+}
+}
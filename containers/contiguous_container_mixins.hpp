@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory>
 #include <stdexcept>
 #include <utility>
 
@@ -28,9 +29,10 @@ struct ContiguousContainerCommonMethods {
         }
         return std::forward<Self>(self).data()[i];
     }
+    // Raw pointer even if the allocator hands out fancy pointers
     template <typename Self>
     constexpr auto* data(this Self&& self) {
-        return std::forward<Self>(self).data_;
+        return std::to_address(std::forward<Self>(self).data_);
     }
     template <typename Self>
     constexpr auto&& back(this Self&& self) {
@@ -72,8 +72,11 @@ class dlist {
     using const_pointer = T const*;
     using iterator = Iterator;
     using reverse_iterator = std::reverse_iterator<Iterator>;
+    using allocator_type = Allocator<Node>;
 
     dlist() noexcept = default;
+    explicit dlist(allocator_type const& alloc)
+        : alloc_{alloc} {}
 
     auto back() noexcept -> reference { return **tail_; }
     auto back() const noexcept -> const_reference { return **tail_; }
@@ -194,7 +197,7 @@ class dlist {
     Node* head_{nullptr};
     Node* tail_{nullptr};
     size_type size_{0};
-    NO_UNIQUE_ADDRESS Allocator<Node> alloc_{};
+    NO_UNIQUE_ADDRESS allocator_type alloc_{};
 
     static_assert(std::input_or_output_iterator<Iterator>);
     static_assert(std::input_iterator<Iterator>);
@@ -0,0 +1,240 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+#include "relocation.hpp"
+
+namespace ml {
+/*
+Modifiers shared by the growable contiguous containers: vector, vector2 and small_vector.
+
+The container befriends this struct and provides data(), cbegin(), clear(), size_ and capacity_, plus
+- grow_to(min_capacity), which grows by the container's policy and may relocate the elements
+- reserve(new_capacity), which grows to exactly new_capacity
+- release(), which frees the block without touching the elements
+
+A value which may refer to an element is copied out before the elements are grown or shifted.
+*/
+struct DynamicArrayModifierMethods {
+    template <typename Self, typename... Args>
+    void emplace_back(this Self& self, Args&&... args) {
+        using T = typename Self::value_type;
+        if (self.size_ == self.capacity_) {
+            // The arguments may refer to elements, which growing relocates
+            T copy{std::forward<Args>(args)...};
+            self.grow_to(self.size_ + 1);
+            new (self.data() + self.size_) T{std::move(copy)};
+        } else {
+            new (self.data() + self.size_) T{std::forward<Args>(args)...};
+        }
+        ++self.size_;
+    }
+    template <typename Self, typename U>
+        requires std::constructible_from<typename Self::value_type, U>
+    void push_back(this Self& self, U&& value) {
+        self.emplace_back(std::forward<U>(value));
+    }
+
+    // Bulk modifiers
+    // Sized and forward ranges grow at most once, trivially copyable elements are copied with memcpy
+    template <typename Self, std::ranges::input_range R>
+    void append_range(this Self& self, R&& range) {
+        if constexpr (std::ranges::sized_range<R> || std::ranges::forward_range<R>) {
+            auto const n{static_cast<std::size_t>(std::ranges::distance(range))};
+            self.grow_to(self.size_ + n);
+            construct_from(std::ranges::begin(range), n, self.data() + self.size_);
+            self.size_ += n;
+        } else {
+            for (auto&& value : range) {
+                self.emplace_back(std::forward<decltype(value)>(value));
+            }
+        }
+    }
+    // Returns an iterator to the first inserted element
+    template <typename Self, std::ranges::input_range R>
+    auto insert_range(this Self& self, typename Self::const_iterator pos, R&& range) -> typename Self::iterator {
+        auto const index{static_cast<std::size_t>(pos - self.cbegin())};
+        if constexpr (std::ranges::sized_range<R> || std::ranges::forward_range<R>) {
+            auto const n{static_cast<std::size_t>(std::ranges::distance(range))};
+            self.grow_to(self.size_ + n);
+            self.insert_gap(index, n, [&range, n](auto* gap) { construct_from(std::ranges::begin(range), n, gap); });
+        } else {
+            // The length isn't known up front so append and rotate into place
+            auto const old_size{self.size_};
+            self.append_range(std::forward<R>(range));
+            std::rotate(self.data() + index, self.data() + old_size, self.data() + self.size_);
+        }
+        return typename Self::iterator(self.data() + index);
+    }
+    template <typename Self, std::ranges::input_range R>
+    void assign_range(this Self& self, R&& range) {
+        self.clear();
+        if constexpr (std::ranges::sized_range<R> || std::ranges::forward_range<R>) {
+            auto const n{static_cast<std::size_t>(std::ranges::distance(range))};
+            if (n > self.capacity_) {
+                // Nothing needs keeping so the old block is freed before the new one is taken
+                self.release();
+                self.reserve(n);
+            }
+        }
+        self.append_range(std::forward<R>(range));
+    }
+
+    // Returns an iterator to the inserted element
+    template <typename Self, typename U>
+        requires std::constructible_from<typename Self::value_type, U>
+    auto insert(this Self& self, typename Self::const_iterator pos, U&& value) -> typename Self::iterator {
+        using T = typename Self::value_type;
+        auto const index{static_cast<std::size_t>(pos - self.cbegin())};
+        T copy{std::forward<U>(value)};
+        self.grow_to(self.size_ + 1);
+        self.insert_gap(index, 1, [&copy](T* gap) { new (gap) T{std::move(copy)}; });
+        return typename Self::iterator(self.data() + index);
+    }
+    template <typename Self>
+    auto erase(this Self& self, typename Self::const_iterator pos) -> typename Self::iterator {
+        return self.erase(pos, pos + 1);
+    }
+    // Returns an iterator to the element after the last one erased
+    template <typename Self>
+    auto erase(this Self& self, typename Self::const_iterator first, typename Self::const_iterator last)
+        -> typename Self::iterator {
+        using T = typename Self::value_type;
+        auto const index{static_cast<std::size_t>(first - self.cbegin())};
+        auto const n{static_cast<std::size_t>(last - first)};
+        auto* const gap{self.data() + index};
+        auto const n_after{self.size_ - index - n};
+
+        if constexpr (is_trivially_relocatable_v<T>) {
+            std::destroy_n(gap, n);
+            relocate_overlapping(gap + n, n_after, gap);
+        } else {
+            std::move(gap + n, self.data() + self.size_, gap);
+            std::destroy_n(gap + n_after, n);
+        }
+        self.size_ -= n;
+        return typename Self::iterator(gap);
+    }
+
+    // New elements are value-initialised
+    template <typename Self>
+    void resize(this Self& self, std::size_t new_size) {
+        self.resize_with(new_size, [](auto* p, std::size_t n) { std::uninitialized_value_construct_n(p, n); });
+    }
+    template <typename Self>
+    void resize(this Self& self, std::size_t new_size, typename Self::value_type const& value) {
+        if (new_size > self.capacity_) {
+            // value may be an element, which growing relocates
+            typename Self::value_type const copy{value};
+            self.resize_with(new_size, [&copy](auto* p, std::size_t n) { std::uninitialized_fill_n(p, n, copy); });
+        } else {
+            self.resize_with(new_size, [&value](auto* p, std::size_t n) { std::uninitialized_fill_n(p, n, value); });
+        }
+    }
+    // New elements are default-initialised, so trivial types are left uninitialised for the caller to write
+    template <typename Self>
+    void resize_for_overwrite(this Self& self, std::size_t new_size) {
+        self.resize_with(new_size, [](auto* p, std::size_t n) { std::uninitialized_default_construct_n(p, n); });
+    }
+    /*
+    Makes room for n more elements and has fill(ptr, n) write them straight into the spare capacity,
+    e.g. from a read() call, without initialising them first.
+    fill returns how many it wrote, or nothing if it always writes all n.
+    Only for trivial types as fill is handed uninitialised memory.
+    */
+    template <typename Self, typename Fill>
+        requires(std::is_trivial_v<typename Self::value_type>
+                 && std::invocable<Fill&, typename Self::value_type*, std::size_t>)
+    auto reserve_and_fill(this Self& self, std::size_t n, Fill fill) -> std::size_t {
+        using T = typename Self::value_type;
+        self.grow_to(self.size_ + n);
+
+        auto* const dest{self.data() + self.size_};
+        auto n_written{n};
+        if constexpr (std::is_void_v<std::invoke_result_t<Fill&, T*, std::size_t>>) {
+            std::invoke(fill, dest, n);
+        } else {
+            n_written = std::min(n, static_cast<std::size_t>(std::invoke(fill, dest, n)));
+        }
+        self.size_ += n_written;
+        return n_written;
+    }
+  protected:
+    // Assignment
+    template <typename Self>
+    void copy_elements_from(this Self& self, Self const& other) {
+        self.clear();
+        self.reserve(other.size_);
+        copy_construct(other.data(), other.size_, self.data());
+        self.size_ = other.size_;
+    }
+    // For when memory can't change hands, e.g. between unequal allocators, so the elements are moved instead
+    template <typename Self>
+    void move_elements_from(this Self& self, Self& other) {
+        self.clear();
+        self.reserve(other.size_);
+        std::uninitialized_move_n(other.data(), other.size_, self.data());
+        self.size_ = other.size_;
+        other.clear();
+    }
+  private:
+    // Copies n elements into uninitialised memory
+    template <typename It, typename T>
+    static void construct_from(It first, std::size_t n, T* dest) {
+        using source_type = std::remove_cvref_t<std::iter_reference_t<It>>;
+        if constexpr (std::contiguous_iterator<It> && std::is_same_v<source_type, T> && std::is_trivially_copyable_v<T>) {
+            if (n) {
+                std::memcpy(static_cast<void*>(dest), static_cast<void const*>(std::to_address(first)), n * sizeof(T));
+            }
+        } else {
+            std::uninitialized_copy_n(std::move(first), n, dest);
+        }
+    }
+    // Opens an n element gap at index and has construct fill it, the capacity must already fit it
+    template <typename Self, typename Construct>
+    void insert_gap(this Self& self, std::size_t index, std::size_t n, Construct construct) {
+        using T = typename Self::value_type;
+        auto const n_after{self.size_ - index};
+        auto* const gap{self.data() + index};
+
+        if constexpr (is_trivially_relocatable_v<T> || std::is_nothrow_move_constructible_v<T>) {
+            // Shift the tail up, and back again if construction throws
+            relocate_overlapping(gap, n_after, gap + n);
+            try {
+                construct(gap);
+            } catch (...) {
+                relocate_overlapping(gap + n, n_after, gap);
+                throw;
+            }
+            self.size_ += n;
+        } else {
+            // Build at the end then rotate into place so a throw leaves the elements untouched
+            construct(self.data() + self.size_);
+            self.size_ += n;
+            std::rotate(gap, self.data() + self.size_ - n, self.data() + self.size_);
+        }
+    }
+    // Shrinks, or grows to exactly new_size and has construct(ptr, n) fill the new elements
+    template <typename Self, typename Construct>
+    void resize_with(this Self& self, std::size_t new_size, Construct construct) {
+        if (new_size <= self.size_) {
+            std::destroy_n(self.data() + new_size, self.size_ - new_size);
+            self.size_ = new_size;
+            return;
+        }
+        self.reserve(new_size);
+        construct(self.data() + self.size_, new_size - self.size_);
+        self.size_ = new_size;
+    }
+};
+}
@@ -5,6 +5,7 @@
 #include "linked_vector_segment.hpp"
 #include "linked_vector_iterator.hpp"
 #include "allocator.hpp"
+#include "relocation.hpp"
 
 #include "preprocessor/platform_def.hpp"
 
@@ -43,6 +44,8 @@ class linked_vector {
     static constexpr auto segment_alignment{alignof(segment_type)};
 
     linked_vector() noexcept = default;
+    explicit linked_vector(allocator_type const& alloc)
+        : alloc_{alloc} {}
     ~linked_vector();
 
     // Element access
@@ -65,6 +68,8 @@ class linked_vector {
 
     // Capacity
     auto capacity() const -> size_type;
+    // Moves the elements into a single segment which fits them exactly
+    void compact();
     auto empty() const -> bool;
     auto reserve(size_type n_elems) -> void;
     auto size() const -> size_type;
@@ -161,6 +166,32 @@ METHOD_START()::rend() const->const_reverse_iterator {
 METHOD_START()::capacity() const->size_type {
     return capacity_;
 }
+METHOD_START()::compact()->void {
+    auto* old_head{head_};
+    head_ = nullptr;
+    tail_ = nullptr;
+    capacity_ = 0;
+
+    if (size_) {
+        construct_segment(size_);
+        capacity_ = size_;
+
+        auto* dest{head_->data};
+        for (auto* segment{old_head}; segment; segment = segment->next) {
+            relocate(segment->data, segment->size, dest);
+            dest += segment->size;
+            // The elements now live in the new segment
+            segment->size = 0;
+        }
+        head_->size = size_;
+    }
+
+    while (old_head) {
+        auto* next_segment{old_head->next};
+        destroy_segment(old_head);
+        old_head = next_segment;
+    }
+}
 METHOD_START()::empty() const->bool {
     return size_ == 0;
 }
@@ -0,0 +1,196 @@
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#if defined(_WIN32)
+#include <malloc.h>
+#elif defined(__APPLE__)
+#include <malloc/malloc.h>
+#else
+#include <malloc.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "malloc_pmr.hpp"
+
+namespace ml {
+namespace {
+#ifdef __linux__
+constexpr bool can_remap{true};
+#else
+constexpr bool can_remap{false};
+#endif
+
+auto system_page_size() -> std::size_t {
+#ifdef __linux__
+    static auto const page{static_cast<std::size_t>(sysconf(_SC_PAGESIZE))};
+    return page;
+#else
+    return 4096;
+#endif
+}
+auto round_to_pages(std::size_t n) -> std::size_t {
+    auto const page{system_page_size()};
+    return ((n + page - 1) / page) * page;
+}
+// malloc only guarantees fundamental alignment
+auto is_over_aligned(std::size_t alignment) -> bool {
+    return alignment > alignof(std::max_align_t);
+}
+}
+
+malloc_pmr::malloc_pmr(size_type mapping_threshold)
+    : mapping_threshold_{mapping_threshold} {}
+
+auto malloc_pmr::usable_size(void* ptr, size_type n_bytes, size_type alignment) const -> size_type {
+    if (!ptr) {
+        return 0;
+    }
+    if (is_mapped(n_bytes, alignment)) {
+        return round_to_pages(n_bytes);
+    }
+#if defined(_WIN32)
+    return is_over_aligned(alignment) ? _aligned_msize(ptr, alignment, 0) : _msize(ptr);
+#elif defined(__APPLE__)
+    return malloc_size(ptr);
+#else
+    return malloc_usable_size(ptr);
+#endif
+}
+
+auto malloc_pmr::do_allocate(size_type n_bytes, size_type alignment) -> void* {
+    void* ptr{nullptr};
+    if (is_mapped(n_bytes, alignment)) {
+#ifdef __linux__
+        ptr = mmap(nullptr, round_to_pages(n_bytes), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (ptr == MAP_FAILED) {
+            ptr = nullptr;
+        }
+#endif
+    } else if (is_over_aligned(alignment)) {
+#ifdef _WIN32
+        ptr = _aligned_malloc(n_bytes, alignment);
+#else
+        if (posix_memalign(&ptr, alignment, n_bytes) != 0) {
+            ptr = nullptr;
+        }
+#endif
+    } else {
+        ptr = std::malloc(n_bytes);
+    }
+
+    if (!ptr) {
+        throw std::bad_alloc{};
+    }
+    return ptr;
+}
+void malloc_pmr::do_deallocate(void* ptr, size_type n_bytes, size_type alignment) {
+    if (!ptr) {
+        return;
+    }
+    if (is_mapped(n_bytes, alignment)) {
+#ifdef __linux__
+        munmap(ptr, round_to_pages(n_bytes));
+#endif
+        return;
+    }
+#ifdef _WIN32
+    if (is_over_aligned(alignment)) {
+        _aligned_free(ptr);
+        return;
+    }
+#endif
+    std::free(ptr);
+}
+auto malloc_pmr::do_extend(void* ptr, size_type old_bytes, size_type new_bytes, size_type alignment) -> void* {
+    if (!ptr) {
+        return do_allocate(new_bytes, alignment);
+    }
+
+    auto const old_mapped{is_mapped(old_bytes, alignment)};
+    if (old_mapped != is_mapped(new_bytes, alignment)) {
+        return do_allocate(new_bytes, alignment);
+    }
+
+    if (old_mapped) {
+#ifdef __linux__
+        // Without MREMAP_MAYMOVE the mapping only grows if the following pages are free
+        auto const old_size{round_to_pages(old_bytes)};
+        auto const new_size{round_to_pages(new_bytes)};
+        if (old_size == new_size || mremap(ptr, old_size, new_size, 0) != MAP_FAILED) {
+            return ptr;
+        }
+#endif
+        return do_allocate(new_bytes, alignment);
+    }
+
+    if (new_bytes <= usable_size(ptr, old_bytes, alignment)) {
+        return ptr;
+    }
+    return do_allocate(new_bytes, alignment);
+}
+auto malloc_pmr::do_reallocate(void* ptr, size_type old_bytes, size_type new_bytes, size_type alignment) -> void* {
+    if (!ptr) {
+        return do_allocate(new_bytes, alignment);
+    }
+
+    auto const old_mapped{is_mapped(old_bytes, alignment)};
+    if (old_mapped != is_mapped(new_bytes, alignment)) {
+        return move_to_new_block(ptr, old_bytes, new_bytes, alignment);
+    }
+
+    if (old_mapped) {
+#ifdef __linux__
+        auto* new_ptr{mremap(ptr, round_to_pages(old_bytes), round_to_pages(new_bytes), MREMAP_MAYMOVE)};
+        if (new_ptr == MAP_FAILED) {
+            throw std::bad_alloc{};
+        }
+        return new_ptr;
+#endif
+    }
+
+    void* new_ptr{nullptr};
+    if (!is_over_aligned(alignment)) {
+        new_ptr = std::realloc(ptr, new_bytes);
+    } else {
+#ifdef _WIN32
+        new_ptr = _aligned_realloc(ptr, new_bytes, alignment);
+#else
+        // There is no aligned realloc so only grow in place
+        if (new_bytes <= usable_size(ptr, old_bytes, alignment)) {
+            return ptr;
+        }
+        return move_to_new_block(ptr, old_bytes, new_bytes, alignment);
+#endif
+    }
+
+    // The old block is untouched if realloc fails
+    if (!new_ptr) {
+        throw std::bad_alloc{};
+    }
+    return new_ptr;
+}
+auto malloc_pmr::do_is_equal(ml::pmr const& other) const noexcept -> bool {
+    // Every instance frees with the same functions but the mapping threshold decides which one
+    auto const* other_malloc{dynamic_cast<malloc_pmr const*>(&other)};
+    return other_malloc && other_malloc->mapping_threshold_ == mapping_threshold_;
+}
+
+auto malloc_pmr::is_mapped(size_type n_bytes, size_type alignment) const -> bool {
+    return can_remap && n_bytes >= mapping_threshold_ && alignment <= system_page_size();
+}
+auto malloc_pmr::move_to_new_block(void* ptr, size_type old_bytes, size_type new_bytes, size_type alignment)
+    -> void* {
+    auto* new_ptr{do_allocate(new_bytes, alignment)};
+    std::memcpy(new_ptr, ptr, std::min(old_bytes, new_bytes));
+    do_deallocate(ptr, old_bytes, alignment);
+    return new_ptr;
+}
+
+auto get_malloc_pmr() -> malloc_pmr* {
+    static malloc_pmr resource;
+    return &resource;
+}
+}
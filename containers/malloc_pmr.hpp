@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+
+#include "pmr.hpp"
+
+namespace ml {
+/*
+Resource over malloc which grows allocations without copying where it can.
+
+extend() stays in place when the block malloc handed out has room to spare.
+Blocks of at least mapping_threshold bytes are mapped directly on Linux so they can be grown with mremap,
+in place by extend() and by remapping the pages by reallocate().
+Smaller blocks are resized with realloc by reallocate().
+*/
+class malloc_pmr : public ml::pmr {
+  public:
+    using size_type = std::size_t;
+
+    static constexpr size_type default_mapping_threshold{256 * 1024};
+
+    malloc_pmr() = default;
+    explicit malloc_pmr(size_type mapping_threshold);
+    ~malloc_pmr() override = default;
+
+    // Access
+    auto mapping_threshold() const -> size_type { return mapping_threshold_; }
+    // Bytes the block can hold without moving, at least n_bytes
+    auto usable_size(void* ptr, size_type n_bytes, size_type alignment) const -> size_type;
+
+    auto do_allocate(size_type n_bytes, size_type alignment) -> void* override final;
+    void do_deallocate(void* ptr, size_type n_bytes, size_type alignment) override final;
+    auto do_extend(void* ptr, size_type old_bytes, size_type new_bytes, size_type alignment) -> void* override final;
+    auto do_reallocate(void* ptr, size_type old_bytes, size_type new_bytes, size_type alignment)
+        -> void* override final;
+    auto do_is_equal(ml::pmr const& other) const noexcept -> bool override final;
+  private:
+    // Whether a block of this size is mapped directly rather than taken from malloc
+    auto is_mapped(size_type n_bytes, size_type alignment) const -> bool;
+    // Moves the contents to a fresh block and frees the old one
+    auto move_to_new_block(void* ptr, size_type old_bytes, size_type new_bytes, size_type alignment) -> void*;
+
+    size_type mapping_threshold_{default_mapping_threshold};
+};
+
+auto get_malloc_pmr() -> malloc_pmr*;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+#include "mapped_file_arena_mmr.hpp"
+#include "offset_ptr.hpp"
+
+namespace ml {
+/*
+Allocator for containers stored in a mapped_file_arena_mmr.
+
+It hands out offset_ptrs and refers to the arena through the file's header, so a container stored in the file
+with its allocator still works after the file is closed and opened again.
+Works with containers which support allocator pointer types, such as std::vector and ml::vector.
+*/
+template <typename T>
+class mapped_file_allocator {
+  public:
+    using value_type = T;
+    using pointer = offset_ptr<T>;
+    using const_pointer = offset_ptr<T const>;
+    using void_pointer = offset_ptr<void>;
+    using const_void_pointer = offset_ptr<void const>;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    template <typename U>
+    struct rebind {
+        using other = mapped_file_allocator<U>;
+    };
+
+    mapped_file_allocator() = default;
+    mapped_file_allocator(mapped_file_arena_mmr* arena)
+        : header_{arena->header()} {}
+
+    mapped_file_allocator(mapped_file_allocator const&) = default;
+    template <typename U>
+    mapped_file_allocator(mapped_file_allocator<U> const& other)
+        : header_{other.header()} {}
+
+    auto operator=(mapped_file_allocator const&) -> mapped_file_allocator& = default;
+
+    // Access
+    auto header() const -> mapped_file_header* { return header_.get(); }
+    auto arena() const -> mapped_file_arena_mmr* { return header_ ? header_->owner : nullptr; }
+
+    // Allocation
+    [[nodiscard]] auto allocate(size_type n_elems) -> pointer {
+        auto* resource{arena()};
+        if (!resource) {
+            throw std::bad_alloc{};
+        }
+        return pointer{static_cast<T*>(resource->allocate(n_elems * sizeof(T), alignof(T)))};
+    }
+    auto deallocate(pointer ptr, size_type n_elems) -> void {
+        if (auto* resource{arena()}) {
+            resource->deallocate(ptr.get(), n_elems * sizeof(T), alignof(T));
+        }
+    }
+
+    template <typename U>
+    auto operator==(mapped_file_allocator<U> const& other) const noexcept -> bool {
+        return header() == other.header();
+    }
+  private:
+    offset_ptr<mapped_file_header> header_{};
+};
+}
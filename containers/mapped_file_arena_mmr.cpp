@@ -0,0 +1,121 @@
+#include <algorithm>
+#include <cerrno>
+#include <system_error>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "mapped_file_arena_mmr.hpp"
+
+namespace ml {
+namespace {
+auto round_up(std::size_t n, std::size_t multiple) -> std::size_t {
+    return ((n + multiple - 1) / multiple) * multiple;
+}
+[[noreturn]] void throw_errno(char const* what) {
+    throw std::system_error{errno, std::generic_category(), what};
+}
+}
+
+#ifdef _WIN32
+mapped_file_arena_mmr::mapped_file_arena_mmr(std::filesystem::path const& /*path*/,
+                                             mapped_file_options const& options)
+    : options_{options} {
+    throw std::system_error{std::make_error_code(std::errc::function_not_supported), "mapped_file_arena_mmr"};
+}
+mapped_file_arena_mmr::~mapped_file_arena_mmr() = default;
+void mapped_file_arena_mmr::sync() {}
+void mapped_file_arena_mmr::grow_to(size_type /*new_size*/) {
+    throw std::bad_alloc{};
+}
+void mapped_file_arena_mmr::release() {}
+#else
+mapped_file_arena_mmr::mapped_file_arena_mmr(std::filesystem::path const& path, mapped_file_options const& options)
+    : options_{options} {
+    auto const page{static_cast<size_type>(sysconf(_SC_PAGESIZE))};
+    options_.grow_granularity = round_up(options_.grow_granularity ? options_.grow_granularity : page, page);
+
+    fd_ = open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd_ < 0) {
+        throw_errno("open");
+    }
+
+    try {
+        struct stat st {};
+        if (fstat(fd_, &st) != 0) {
+            throw_errno("fstat");
+        }
+        capacity_ = static_cast<size_type>(st.st_size);
+        reserved_ = round_up(std::max({options_.reserve_bytes, capacity_, sizeof(mapped_file_header)}),
+                             options_.grow_granularity);
+
+        // Mapping past the end of the file is allowed, the file is grown before those pages are touched
+        auto* ptr{mmap(nullptr, reserved_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0)};
+        if (ptr == MAP_FAILED) {
+            throw_errno("mmap");
+        }
+        base_ = static_cast<std::byte*>(ptr);
+
+        if (capacity_ >= sizeof(mapped_file_header)) {
+            auto const& h{*header()};
+            if (h.magic != mapped_file_header::expected_magic || h.version != mapped_file_header::current_version ||
+                h.size > capacity_) {
+                throw std::system_error{std::make_error_code(std::errc::invalid_argument),
+                                        "not a mapped_file_arena_mmr file"};
+            }
+            reopened_ = true;
+        } else if (capacity_ == 0) {
+            grow_to(sizeof(mapped_file_header));
+            new (base_) mapped_file_header{};
+            header()->size = sizeof(mapped_file_header);
+        } else {
+            throw std::system_error{std::make_error_code(std::errc::invalid_argument),
+                                    "not a mapped_file_arena_mmr file"};
+        }
+        header()->owner = this;
+    } catch (...) {
+        release();
+        throw;
+    }
+}
+mapped_file_arena_mmr::~mapped_file_arena_mmr() {
+    release();
+}
+
+void mapped_file_arena_mmr::sync() {
+    if (msync(base_, capacity_, MS_SYNC) != 0) {
+        throw_errno("msync");
+    }
+}
+
+void mapped_file_arena_mmr::grow_to(size_type new_size) {
+    if (new_size > reserved_) {
+        throw std::bad_alloc{};
+    }
+
+    auto const new_capacity{std::min(round_up(new_size, options_.grow_granularity), reserved_)};
+    if (ftruncate(fd_, static_cast<off_t>(new_capacity)) != 0) {
+        throw std::bad_alloc{};
+    }
+    capacity_ = new_capacity;
+}
+
+void mapped_file_arena_mmr::release() {
+    if (base_) {
+        // munmap doesn't lose data, the kernel writes shared pages back on its own schedule
+        munmap(base_, reserved_);
+    }
+    if (fd_ >= 0) {
+        close(fd_);
+    }
+    base_ = nullptr;
+    capacity_ = 0;
+    reserved_ = 0;
+    fd_ = -1;
+}
+#endif
+}
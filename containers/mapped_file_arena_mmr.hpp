@@ -0,0 +1,186 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <new>
+#include <utility>
+
+#include "offset_ptr.hpp"
+
+namespace ml {
+class mapped_file_arena_mmr;
+
+struct mapped_file_options {
+    // Largest the file can grow to, the whole range is mapped up front so addresses stay put while it's open
+    std::size_t reserve_bytes{std::size_t{1} << 30};
+    // The file is grown in multiples of this
+    std::size_t grow_granularity{std::size_t{1} << 20};
+};
+
+// Start of every arena file
+struct mapped_file_header {
+    static constexpr std::uint64_t expected_magic{0x616e6572615f6c6d}; // "ml_arena"
+    static constexpr std::uint64_t current_version{1};
+
+    std::uint64_t magic{expected_magic};
+    std::uint64_t version{current_version};
+    // Bytes in use from the start of the file, including this header
+    std::uint64_t size{0};
+    offset_ptr<void> root{};
+    // Rewritten every time the file is opened so allocators stored in the file can find the arena
+    mapped_file_arena_mmr* owner{nullptr};
+};
+
+/*
+Arena backed by a memory-mapped file.
+
+Everything allocated from it lives in the file, so structures built with offset_ptr and mapped_file_allocator
+can be saved with sync() and used again by opening the same file, without any deserialisation.
+Opening only maps the file so the cost is in the pages later touched rather than the number of elements.
+One root pointer is stored in the header to find the structures again.
+Raw pointers into the file are only valid until it is closed.
+Only POSIX (mmap) is supported.
+*/
+class mapped_file_arena_mmr {
+  public:
+    using size_type = std::size_t;
+
+    // Opens the file if it holds an arena, otherwise creates one
+    explicit mapped_file_arena_mmr(std::filesystem::path const& path, mapped_file_options const& options = {});
+    ~mapped_file_arena_mmr();
+
+    // The header points back at the arena so it can't be copied or moved
+    mapped_file_arena_mmr(mapped_file_arena_mmr const&) = delete;
+    mapped_file_arena_mmr(mapped_file_arena_mmr&&) = delete;
+
+    auto operator=(mapped_file_arena_mmr const&) -> mapped_file_arena_mmr& = delete;
+    auto operator=(mapped_file_arena_mmr&&) -> mapped_file_arena_mmr& = delete;
+
+    // Access
+    auto data() const -> std::byte*;
+    auto header() const -> mapped_file_header*;
+    auto options() const -> mapped_file_options const&;
+    // Whether the arena was loaded from an existing file
+    auto reopened() const -> bool;
+
+    // Capacity
+    auto size() const -> size_type;
+    // Bytes of file backing the mapping
+    auto capacity() const -> size_type;
+    auto reserved() const -> size_type;
+
+    // Allocation
+    [[nodiscard]] auto allocate(size_type n_bytes, size_type alignment) -> void*;
+    auto deallocate(void* ptr, size_type n_bytes, size_type alignment) -> void;
+    // Grows in place if ptr is the most recent allocation and the reservation has room
+    [[nodiscard]] auto extend(void* ptr, size_type old_bytes, size_type new_bytes, size_type alignment)
+        -> void*;
+
+    // Root
+    template <typename T>
+    auto root() const -> T*;
+    void set_root(void* ptr);
+    // Returns the stored root, constructing it first if the file is new
+    template <typename T, typename... Args>
+    auto find_or_make_root(Args&&... args) -> T&;
+
+    // Persistence
+    // Flushes the mapping to the file
+    void sync();
+  private:
+    // Grows the file so that at least new_size bytes are usable
+    void grow_to(size_type new_size);
+    void release();
+
+    std::byte* base_{nullptr};
+    size_type capacity_{0};
+    size_type reserved_{0};
+    int fd_{-1};
+    bool reopened_{false};
+    mapped_file_options options_{};
+};
+
+// Access
+inline auto mapped_file_arena_mmr::data() const -> std::byte* {
+    return base_;
+}
+inline auto mapped_file_arena_mmr::header() const -> mapped_file_header* {
+    return reinterpret_cast<mapped_file_header*>(base_);
+}
+inline auto mapped_file_arena_mmr::options() const -> mapped_file_options const& {
+    return options_;
+}
+inline auto mapped_file_arena_mmr::reopened() const -> bool {
+    return reopened_;
+}
+// Capacity
+inline auto mapped_file_arena_mmr::size() const -> size_type {
+    return static_cast<size_type>(header()->size);
+}
+inline auto mapped_file_arena_mmr::capacity() const -> size_type {
+    return capacity_;
+}
+inline auto mapped_file_arena_mmr::reserved() const -> size_type {
+    return reserved_;
+}
+// Allocation
+inline auto mapped_file_arena_mmr::allocate(size_type n_bytes, size_type alignment) -> void* {
+    auto const size{this->size()};
+    auto const start{reinterpret_cast<std::uintptr_t>(base_) + size};
+    auto const padding{(alignment - (start % alignment)) % alignment};
+    auto const new_size{size + padding + n_bytes};
+
+    if (new_size > capacity_) {
+        grow_to(new_size);
+    }
+
+    auto* ptr{base_ + size + padding};
+    header()->size = new_size;
+    return ptr;
+}
+inline auto mapped_file_arena_mmr::deallocate(void* /*ptr*/, size_type /*n_bytes*/, size_type /*alignment*/)
+    -> void {
+    // no-op
+    return;
+}
+inline auto mapped_file_arena_mmr::extend(void* ptr, size_type old_bytes, size_type new_bytes, size_type alignment)
+    -> void* {
+    if (!ptr) {
+        return allocate(new_bytes, alignment);
+    }
+    if (new_bytes <= old_bytes) {
+        return ptr;
+    }
+
+    auto const size{this->size()};
+    auto* const expected_start{base_ + size - old_bytes};
+    if ((old_bytes > size) || (expected_start != ptr)) {
+        return allocate(new_bytes, alignment);
+    }
+
+    auto const new_size{size + (new_bytes - old_bytes)};
+    if (new_size > capacity_) {
+        grow_to(new_size);
+    }
+    header()->size = new_size;
+    return ptr;
+}
+// Root
+template <typename T>
+inline auto mapped_file_arena_mmr::root() const -> T* {
+    return static_cast<T*>(header()->root.get());
+}
+inline void mapped_file_arena_mmr::set_root(void* ptr) {
+    header()->root = ptr;
+}
+template <typename T, typename... Args>
+inline auto mapped_file_arena_mmr::find_or_make_root(Args&&... args) -> T& {
+    if (auto* existing{root<T>()}) {
+        return *existing;
+    }
+    auto* object{new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...)};
+    set_root(object);
+    return *object;
+}
+}
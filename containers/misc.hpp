@@ -1,8 +1,12 @@
 #pragma once
 
+#include <cstddef>
 #include <utility>
 
 namespace ml {
+// Used to pad shared state so neighbouring atomics don't false-share
+inline constexpr std::size_t cache_line_size{64};
+
 template <typename T, typename U>
 auto&& max(T&& a, U&& b) {
     return (a < b) ? std::forward<T>(b) : std::forward<T>(a);
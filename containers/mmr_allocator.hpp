@@ -1,5 +1,7 @@
 #pragma once
 
+#include "memory_resource_concepts.hpp"
+
 namespace ml {
 template <typename T, typename MemoryResource>
 class mmr_allocator {
@@ -37,7 +39,14 @@ class mmr_allocator {
     [[nodiscard]] auto allocate_bytes(size_type n_bytes, size_type alignment) -> void*;
     auto deallocate(pointer ptr, size_type n_elems) -> void;
     auto deallocate_bytes(void* ptr, size_type n_bytes, size_type alignment) -> void;
+    [[nodiscard]] auto extend(pointer ptr, size_type old_elems, size_type new_elems) -> pointer;
     [[nodiscard]] auto extend_bytes(void* ptr, size_type old_bytes, size_type new_bytes, size_type alignment) -> void*;
+    // Reallocation, only for trivially relocatable T
+    [[nodiscard]] auto reallocate(pointer ptr, size_type old_elems, size_type new_elems) -> pointer
+        requires reallocatable_memory_resource<MemoryResource>;
+    [[nodiscard]] auto reallocate_bytes(void* ptr, size_type old_bytes, size_type new_bytes, size_type alignment)
+        -> void*
+        requires reallocatable_memory_resource<MemoryResource>;
 
     // Object construction
     template <typename... Args>
@@ -65,12 +74,33 @@ inline auto mmr_allocator<T, MemoryResource>::allocate_bytes(size_type n_bytes,
     return resource_->allocate(n_bytes, alignment);
 }
 template <typename T, typename MemoryResource>
+inline auto mmr_allocator<T, MemoryResource>::extend(pointer ptr, size_type old_elems, size_type new_elems)
+    -> pointer {
+    return static_cast<pointer>(extend_bytes(ptr, old_elems * sizeof(T), new_elems * sizeof(T), alignof(T)));
+}
+template <typename T, typename MemoryResource>
 inline auto mmr_allocator<T, MemoryResource>::extend_bytes(void* ptr,
                                                            size_type old_bytes,
                                                            size_type new_bytes,
                                                            size_type alignment) -> void* {
     return resource_->extend(ptr, old_bytes, new_bytes, alignment);
 }
+template <typename T, typename MemoryResource>
+inline auto mmr_allocator<T, MemoryResource>::reallocate(pointer ptr, size_type old_elems, size_type new_elems)
+    -> pointer
+    requires reallocatable_memory_resource<MemoryResource>
+{
+    return static_cast<pointer>(reallocate_bytes(ptr, old_elems * sizeof(T), new_elems * sizeof(T), alignof(T)));
+}
+template <typename T, typename MemoryResource>
+inline auto mmr_allocator<T, MemoryResource>::reallocate_bytes(void* ptr,
+                                                               size_type old_bytes,
+                                                               size_type new_bytes,
+                                                               size_type alignment) -> void*
+    requires reallocatable_memory_resource<MemoryResource>
+{
+    return resource_->reallocate(ptr, old_bytes, new_bytes, alignment);
+}
 
 template <typename T, typename MemoryResource>
 inline auto mmr_allocator<T, MemoryResource>::deallocate(pointer ptr, size_type n_elems) -> void {
@@ -3,18 +3,90 @@
 #include "multi_arena_pmr.hpp"
 
 namespace ml {
-multi_arena_pmr::multi_arena_pmr(std::size_t n_resources, std::size_t initial_capacity) {
-    resources_.reserve(n_resources);
+namespace {
+std::atomic<std::size_t> next_instance_id{1};
 
+struct thread_binding {
+    std::size_t id{0};
+    std::size_t slot{0};
+    arena_pmr* arena{nullptr};
+};
+
+// Releases every arena the thread claimed when it exits
+template <typename SharedState>
+struct thread_bindings {
+    struct entry {
+        thread_binding binding;
+        std::weak_ptr<SharedState> state;
+    };
+
+    ~thread_bindings() {
+        for (auto& e : entries) {
+            if (auto state{e.state.lock()}) {
+                state->release(e.binding.slot);
+            }
+        }
+    }
+
+    std::vector<entry> entries;
+};
+}
+
+multi_arena_pmr::shared_state::shared_state(std::size_t n_resources_, std::size_t initial_capacity_)
+    : arenas{std::make_unique<thread_arena[]>(n_resources_)}
+    , n_resources{n_resources_}
+    , initial_capacity{initial_capacity_}
+    , id{next_instance_id.fetch_add(1, std::memory_order_relaxed)} {
     for (std::size_t i = 0; i < n_resources; ++i) {
-        resources_.emplace_back(initial_capacity);
+        arenas[i].arena = arena_pmr{initial_capacity};
     }
 }
+auto multi_arena_pmr::shared_state::claim() -> std::size_t {
+    for (std::size_t i = 0; i < n_resources; ++i) {
+        auto& slot{arenas[i].claimed};
+        if (!slot.load(std::memory_order_relaxed) && !slot.exchange(true, std::memory_order_acquire)) {
+            return i;
+        }
+    }
+    throw std::runtime_error("No free arena for the calling thread");
+}
+void multi_arena_pmr::shared_state::release(std::size_t i) {
+    arenas[i].arena = arena_pmr{initial_capacity};
+    arenas[i].claimed.store(false, std::memory_order_release);
+}
+
+multi_arena_pmr::multi_arena_pmr(std::size_t n_resources, std::size_t initial_capacity)
+    : state_{std::make_shared<shared_state>(n_resources, initial_capacity)} {}
 
 auto multi_arena_pmr::get_resource(std::size_t i) -> arena_pmr* {
-    if (i >= resources_.size()) {
+    if (i >= state_->n_resources) {
         throw std::out_of_range("Invalid resource index");
     }
-    return &resources_[i];
+    return &state_->arenas[i].arena;
+}
+auto multi_arena_pmr::n_resources() const -> std::size_t {
+    return state_->n_resources;
+}
+
+auto multi_arena_pmr::bind_thread() -> arena_pmr* {
+    static thread_local thread_bindings<shared_state> bindings;
+
+    auto& entries{bindings.entries};
+    std::erase_if(entries, [](auto const& e) { return e.state.expired(); });
+
+    // The thread may already own an arena here if it has used another instance since
+    for (auto const& e : entries) {
+        if (e.binding.id == state_->id) {
+            thread_cache_ = {e.binding.id, e.binding.arena};
+            return e.binding.arena;
+        }
+    }
+
+    auto const slot{state_->claim()};
+    auto* arena{&state_->arenas[slot].arena};
+    entries.push_back({{state_->id, slot, arena}, state_});
+
+    thread_cache_ = {state_->id, arena};
+    return arena;
 }
 }
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <atomic>
 #include <cstddef>
+#include <memory>
 #include <vector>
 
 #include "arena_mmr.hpp"
@@ -8,16 +10,74 @@
 #include "misc.hpp"
 
 namespace ml {
+/*
+A fixed set of arenas which can be selected by index or by the calling thread.
+
+get_thread_resource() binds the calling thread to a free arena on first use.
+Later calls hit a thread-local cache and take no lock.
+When the thread exits its arena's pools are released and the arena can be claimed by another thread.
+
+Arena deallocation is a no-op so memory may be freed from any thread.
+The memory stays valid until the thread which allocated it exits or the multi_arena_pmr is destroyed.
+Don't mix index access with thread access on the same arena.
+*/
 class multi_arena_pmr {
-  private:
-    std::vector<arena_pmr> resources_;
   public:
     multi_arena_pmr() = delete;
     multi_arena_pmr(std::size_t n_resources, std::size_t initial_capacity);
 
+    // A copy would share the arenas and thread bindings of the original
+    multi_arena_pmr(multi_arena_pmr const&) = delete;
+    multi_arena_pmr(multi_arena_pmr&&) = default;
+
+    auto operator=(multi_arena_pmr const&) -> multi_arena_pmr& = delete;
+    auto operator=(multi_arena_pmr&&) -> multi_arena_pmr& = default;
+
+    // Access
     auto get_resource(std::size_t i) -> arena_pmr*;
+    auto get_thread_resource() -> arena_pmr*;
+
+    // Capacity
+    auto n_resources() const -> std::size_t;
+  private:
+    // Padded so the bump pointers of neighbouring threads never share a cache line
+    struct alignas(cache_line_size) thread_arena {
+        arena_pmr arena;
+        std::atomic<bool> claimed{false};
+    };
+    struct shared_state {
+        shared_state(std::size_t n_resources, std::size_t initial_capacity);
+
+        auto claim() -> std::size_t;
+        void release(std::size_t i);
+
+        std::unique_ptr<thread_arena[]> arenas;
+        std::size_t n_resources{0};
+        std::size_t initial_capacity{0};
+        // Identifies the instance in thread-local caches as addresses can be reused
+        std::size_t id{0};
+    };
+    struct thread_cache {
+        std::size_t id{0};
+        arena_pmr* arena{nullptr};
+    };
+
+    auto bind_thread() -> arena_pmr*;
+
+    static thread_local thread_cache thread_cache_;
+    // Shared with the thread-exit hooks so they can tell if the instance still exists
+    std::shared_ptr<shared_state> state_;
 };
 
+inline thread_local multi_arena_pmr::thread_cache multi_arena_pmr::thread_cache_{};
+
+inline auto multi_arena_pmr::get_thread_resource() -> arena_pmr* {
+    if (thread_cache_.id == state_->id) {
+        return thread_cache_.arena;
+    }
+    return bind_thread();
+}
+
 template <typename... Types>
 class multi_t_arena_pmr {
   private:
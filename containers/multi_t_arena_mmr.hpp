@@ -0,0 +1,178 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <tuple>
+
+#include "arena_mmr.hpp"
+#include "misc.hpp"
+#include "mmr_allocator.hpp"
+
+namespace ml {
+enum class arena_slot_mode {
+    // Requests of any size, memory is only reclaimed by reset()
+    variable,
+    // Single objects freed back to the arena are kept on a free list and handed out again
+    fixed
+};
+
+// Compile-time settings for one type's arena in a multi_t_arena_mmr
+template <typename T, std::size_t InitialCapacity = 1024, arena_slot_mode Mode = arena_slot_mode::variable>
+struct arena_for {
+    using type = T;
+    static constexpr std::size_t initial_capacity{InitialCapacity};
+    static constexpr arena_slot_mode mode{Mode};
+};
+
+// Plain types get the default settings
+template <typename T>
+struct arena_spec {
+    using type = arena_for<T>;
+};
+template <typename T, std::size_t InitialCapacity, arena_slot_mode Mode>
+struct arena_spec<arena_for<T, InitialCapacity, Mode>> {
+    using type = arena_for<T, InitialCapacity, Mode>;
+};
+
+/*
+Arena for objects of one type.
+
+In fixed slot mode, freeing a single T pushes it onto an intrusive free list
+which the next single T allocation pops, so node-like types are recycled without a reset.
+*/
+template <typename T, std::size_t InitialCapacity, arena_slot_mode Mode>
+class typed_arena_mmr {
+  public:
+    using size_type = std::size_t;
+    using value_type = T;
+
+    static constexpr arena_slot_mode mode{Mode};
+
+    typed_arena_mmr() = default;
+    explicit typed_arena_mmr(arena_growth_policy const& policy)
+        : arena_{InitialCapacity, policy} {}
+
+    // Allocators point at the arena so it can't be moved
+    typed_arena_mmr(typed_arena_mmr const&) = delete;
+    typed_arena_mmr(typed_arena_mmr&&) = delete;
+
+    auto operator=(typed_arena_mmr const&) -> typed_arena_mmr& = delete;
+    auto operator=(typed_arena_mmr&&) -> typed_arena_mmr& = delete;
+
+    // Access
+    auto arena() const -> arena_mmr const& { return arena_; }
+    auto n_free_slots() const -> size_type { return n_free_slots_; }
+
+    // Allocation
+    [[nodiscard]] auto allocate(size_type n_bytes, size_type alignment) -> void* {
+        if constexpr (Mode == arena_slot_mode::fixed) {
+            if (is_slot(n_bytes, alignment)) {
+                if (free_slots_) {
+                    auto* slot{free_slots_};
+                    free_slots_ = slot->next;
+                    --n_free_slots_;
+                    return slot;
+                }
+                // Any slot may later be handed out as a T so it gets T's alignment whatever was asked for
+                return arena_.allocate(n_bytes, alignof(T));
+            }
+        }
+        return arena_.allocate(n_bytes, alignment);
+    }
+    void deallocate(void* ptr, size_type n_bytes, size_type alignment) {
+        if constexpr (Mode == arena_slot_mode::fixed) {
+            if (ptr && is_slot(n_bytes, alignment)) {
+                free_slots_ = new (ptr) free_slot{free_slots_};
+                ++n_free_slots_;
+                return;
+            }
+        }
+        arena_.deallocate(ptr, n_bytes, alignment);
+    }
+    [[nodiscard]] auto extend(void* ptr, size_type old_bytes, size_type new_bytes, size_type alignment) -> void* {
+        return arena_.extend(ptr, old_bytes, new_bytes, alignment);
+    }
+
+    // Rewinding
+    void reset() {
+        free_slots_ = nullptr;
+        n_free_slots_ = 0;
+        arena_.reset();
+    }
+  private:
+    struct free_slot {
+        free_slot* next;
+    };
+
+    // Free slots hold the list link so they must be able to fit it
+    static_assert(Mode == arena_slot_mode::variable ||
+                      (sizeof(T) >= sizeof(free_slot) && alignof(T) >= alignof(free_slot)),
+                  "Fixed slot mode needs objects at least as large and aligned as a pointer");
+
+    static constexpr auto is_slot(size_type n_bytes, size_type alignment) -> bool {
+        return n_bytes == sizeof(T) && alignment <= alignof(T);
+    }
+
+    arena_mmr arena_{InitialCapacity};
+    free_slot* free_slots_{nullptr};
+    size_type n_free_slots_{0};
+};
+
+/*
+Monomorphic counterpart to multi_t_arena_pmr.
+
+Holds one arena per type in a tuple and picks it at compile time, so allocating through
+the typed allocators inlines down to the arena's pointer bump with no lookup or virtual call.
+Each type is either a plain type or an arena_for<T, initial capacity, slot mode>.
+*/
+template <typename... Specs>
+class multi_t_arena_mmr {
+  private:
+    using Indexer = types_to_index<typename arena_spec<Specs>::type::type...>;
+
+    template <typename Spec>
+    using arena_of = typed_arena_mmr<typename Spec::type, Spec::initial_capacity, Spec::mode>;
+    using arenas_type = std::tuple<arena_of<typename arena_spec<Specs>::type>...>;
+  public:
+    using size_type = std::size_t;
+
+    template <typename T>
+    using resource_type = std::tuple_element_t<Indexer::template get<T>(), arenas_type>;
+    template <typename T>
+    using allocator_type = mmr_allocator<T, resource_type<T>>;
+
+    multi_t_arena_mmr() = default;
+
+    // Allocators point into the instance so it can't be moved
+    multi_t_arena_mmr(multi_t_arena_mmr const&) = delete;
+    multi_t_arena_mmr(multi_t_arena_mmr&&) = delete;
+
+    auto operator=(multi_t_arena_mmr const&) -> multi_t_arena_mmr& = delete;
+    auto operator=(multi_t_arena_mmr&&) -> multi_t_arena_mmr& = delete;
+
+    // Access
+    template <typename T>
+    auto get_resource() -> resource_type<T>* {
+        return &std::get<Indexer::template get<T>()>(arenas_);
+    }
+    template <typename T>
+    auto get_allocator() -> allocator_type<T> {
+        return allocator_type<T>{get_resource<T>()};
+    }
+
+    // Capacity
+    auto total_size() const -> size_type {
+        return std::apply([](auto const&... arenas) { return (arenas.arena().total_size() + ...); }, arenas_);
+    }
+    auto total_capacity() const -> size_type {
+        return std::apply([](auto const&... arenas) { return (arenas.arena().total_capacity() + ...); }, arenas_);
+    }
+
+    // Rewinding
+    void reset() {
+        std::apply([](auto&... arenas) { (arenas.reset(), ...); }, arenas_);
+    }
+  private:
+    arenas_type arenas_;
+};
+}
@@ -0,0 +1,168 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "arena_mmr.hpp"
+#include "pmr.hpp"
+#include "resource_mixins.hpp"
+
+namespace ml {
+// A saved object arena position which can be rewound to
+struct object_arena_mark {
+    arena_mmr_mark arena{};
+    // Destructors registered when the mark was taken
+    std::size_t n_destructors{0};
+};
+
+/*
+Arena which constructs objects and remembers which ones need destroying.
+
+make() records a destructor for objects which aren't trivially destructible, trivially destructible ones cost nothing extra.
+The records live in blocks allocated from the arena itself.
+reset(), rewind() and the destructor run the recorded destructors in reverse order of construction before releasing the memory,
+so a whole object graph can be torn down with one call.
+Usable as both a std::pmr::memory_resource and an ml::pmr, memory taken through those isn't tracked.
+*/
+class object_arena_pmr : public pmr_mixins::dual_pmr<object_arena_pmr> {
+    friend class pmr_mixins::dual_pmr<object_arena_pmr>;
+  public:
+    using size_type = std::size_t;
+
+    static constexpr size_type destructors_per_block{64};
+
+    object_arena_pmr() = default;
+    explicit object_arena_pmr(size_type initial_capacity, arena_growth_policy const& policy = {});
+    ~object_arena_pmr() override;
+
+    // Objects may point at the resource so it can't be moved
+    object_arena_pmr(object_arena_pmr const&) = delete;
+    object_arena_pmr(object_arena_pmr&&) = delete;
+
+    auto operator=(object_arena_pmr const&) -> object_arena_pmr& = delete;
+    auto operator=(object_arena_pmr&&) -> object_arena_pmr& = delete;
+
+    // Access
+    auto arena() const -> arena_mmr const& { return arena_; }
+    auto n_destructors() const -> size_type { return n_destructors_; }
+
+    // Objects
+    template <typename T, typename... Args>
+    auto make(Args&&... args) -> T&;
+    // Value-initialises n objects
+    template <typename T>
+    auto make_array(size_type n) -> T*;
+
+    // Rewinding
+    // Destroys every object then discards every allocation
+    void reset();
+    auto mark() const -> object_arena_mark;
+    // Destroys the objects made since m was taken then discards the allocations
+    void rewind(object_arena_mark m);
+  protected:
+    auto do_allocate(std::size_t n_bytes, std::size_t alignment) -> void* override final {
+        return arena_.allocate(n_bytes, alignment);
+    }
+    void do_deallocate(void* ptr, std::size_t n_bytes, std::size_t alignment) override final {
+        arena_.deallocate(ptr, n_bytes, alignment);
+    }
+    auto do_extend(void* ptr, std::size_t old_bytes, std::size_t new_bytes, std::size_t alignment)
+        -> void* override final {
+        return arena_.extend(ptr, old_bytes, new_bytes, alignment);
+    }
+  private:
+    struct destructor {
+        void (*destroy)(void* objects, size_type n){nullptr};
+        void* objects{nullptr};
+        size_type n{0};
+    };
+    struct destructor_block {
+        destructor_block* previous{nullptr};
+        size_type size{0};
+        destructor entries[destructors_per_block]{};
+    };
+
+    template <typename T>
+    static void destroy_objects(void* objects, size_type n) {
+        auto* typed{static_cast<T*>(objects)};
+        for (size_type i{n}; i > 0; --i) {
+            typed[i - 1].~T();
+        }
+    }
+    void register_destructor(destructor d);
+    // Runs destructors, newest first, until n_destructors remain
+    void run_destructors(size_type n_destructors);
+
+    arena_mmr arena_{};
+    destructor_block* block_{nullptr};
+    size_type n_destructors_{0};
+};
+
+// Ctor
+inline object_arena_pmr::object_arena_pmr(size_type initial_capacity, arena_growth_policy const& policy)
+    : arena_{initial_capacity, policy} {}
+inline object_arena_pmr::~object_arena_pmr() {
+    run_destructors(0);
+}
+// Objects
+template <typename T, typename... Args>
+inline auto object_arena_pmr::make(Args&&... args) -> T& {
+    auto* object{new (arena_.allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...)};
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+        register_destructor({&destroy_objects<T>, object, 1});
+    }
+    return *object;
+}
+template <typename T>
+inline auto object_arena_pmr::make_array(size_type n) -> T* {
+    auto* objects{static_cast<T*>(arena_.allocate(n * sizeof(T), alignof(T)))};
+    size_type n_made{0};
+    try {
+        for (; n_made < n; ++n_made) {
+            new (objects + n_made) T();
+        }
+    } catch (...) {
+        destroy_objects<T>(objects, n_made);
+        throw;
+    }
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+        register_destructor({&destroy_objects<T>, objects, n});
+    }
+    return objects;
+}
+// Rewinding
+inline void object_arena_pmr::reset() {
+    run_destructors(0);
+    arena_.reset();
+}
+inline auto object_arena_pmr::mark() const -> object_arena_mark {
+    return {arena_.mark(), n_destructors_};
+}
+inline void object_arena_pmr::rewind(object_arena_mark m) {
+    run_destructors(m.n_destructors);
+    arena_.rewind(m.arena);
+}
+// Destructors
+inline void object_arena_pmr::register_destructor(destructor d) {
+    if (!block_ || block_->size == destructors_per_block) {
+        auto* memory{arena_.allocate(sizeof(destructor_block), alignof(destructor_block))};
+        block_ = new (memory) destructor_block{block_};
+    }
+    block_->entries[block_->size++] = d;
+    ++n_destructors_;
+}
+inline void object_arena_pmr::run_destructors(size_type n_destructors) {
+    while (n_destructors_ > n_destructors) {
+        auto& d{block_->entries[--block_->size]};
+        d.destroy(d.objects, d.n);
+        --n_destructors_;
+        if (block_->size == 0) {
+            // The block's memory goes with the arena
+            block_ = block_->previous;
+        }
+    }
+}
+}
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+
+namespace ml {
+/*
+Pointer which stores the distance to its target rather than an address.
+
+An offset_ptr and its target in the same mapping stay valid wherever the mapping is placed,
+so structures built from them can be saved to a file and mapped back in without fixing anything up.
+Copying recomputes the distance from the new location.
+*/
+template <typename T>
+class offset_ptr {
+  public:
+    using element_type = T;
+    using value_type = std::remove_cv_t<T>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = T*;
+    using reference = std::add_lvalue_reference_t<T>;
+    using iterator_category = std::random_access_iterator_tag;
+    using iterator_concept = std::contiguous_iterator_tag;
+
+    template <typename U>
+    using rebind = offset_ptr<U>;
+
+    offset_ptr() noexcept = default;
+    offset_ptr(std::nullptr_t) noexcept {}
+    offset_ptr(T* ptr) noexcept { set(ptr); }
+    offset_ptr(offset_ptr const& other) noexcept { set(other.get()); }
+    template <typename U>
+        requires std::is_convertible_v<U*, T*>
+    offset_ptr(offset_ptr<U> const& other) noexcept {
+        set(other.get());
+    }
+    // For casts from void and down a class hierarchy
+    template <typename U>
+        requires(!std::is_convertible_v<U*, T*> && requires(U* u) { static_cast<T*>(u); })
+    explicit offset_ptr(offset_ptr<U> const& other) noexcept {
+        set(static_cast<T*>(other.get()));
+    }
+
+    auto operator=(offset_ptr const& other) noexcept -> offset_ptr& {
+        set(other.get());
+        return *this;
+    }
+    auto operator=(T* ptr) noexcept -> offset_ptr& {
+        set(ptr);
+        return *this;
+    }
+    auto operator=(std::nullptr_t) noexcept -> offset_ptr& {
+        offset_ = null_offset;
+        return *this;
+    }
+
+    // Access
+    auto get() const noexcept -> T* {
+        if (offset_ == null_offset) {
+            return nullptr;
+        }
+        return reinterpret_cast<T*>(reinterpret_cast<std::uintptr_t>(this) + static_cast<std::uintptr_t>(offset_));
+    }
+    auto operator->() const noexcept -> T* { return get(); }
+    auto operator*() const noexcept -> reference
+        requires(!std::is_void_v<T>)
+    {
+        return *get();
+    }
+    auto operator[](difference_type i) const noexcept -> reference
+        requires(!std::is_void_v<T>)
+    {
+        return get()[i];
+    }
+    explicit operator bool() const noexcept { return offset_ != null_offset; }
+
+    // A template so that offset_ptr<void> doesn't declare a void parameter
+    template <typename U = T>
+        requires(!std::is_void_v<U>)
+    static auto pointer_to(U& ref) noexcept -> offset_ptr {
+        return offset_ptr{std::addressof(ref)};
+    }
+
+    // Arithmetic
+    auto operator++() noexcept -> offset_ptr& {
+        offset_ += static_cast<difference_type>(sizeof(T));
+        return *this;
+    }
+    auto operator++(int) noexcept -> offset_ptr {
+        auto out{*this};
+        ++*this;
+        return out;
+    }
+    auto operator--() noexcept -> offset_ptr& {
+        offset_ -= static_cast<difference_type>(sizeof(T));
+        return *this;
+    }
+    auto operator--(int) noexcept -> offset_ptr {
+        auto out{*this};
+        --*this;
+        return out;
+    }
+    auto operator+=(difference_type n) noexcept -> offset_ptr& {
+        offset_ += n * static_cast<difference_type>(sizeof(T));
+        return *this;
+    }
+    auto operator-=(difference_type n) noexcept -> offset_ptr& {
+        offset_ -= n * static_cast<difference_type>(sizeof(T));
+        return *this;
+    }
+    friend auto operator+(offset_ptr const& ptr, difference_type n) noexcept -> offset_ptr {
+        return offset_ptr{ptr.get() + n};
+    }
+    friend auto operator+(difference_type n, offset_ptr const& ptr) noexcept -> offset_ptr {
+        return offset_ptr{ptr.get() + n};
+    }
+    friend auto operator-(offset_ptr const& ptr, difference_type n) noexcept -> offset_ptr {
+        return offset_ptr{ptr.get() - n};
+    }
+    friend auto operator-(offset_ptr const& lhs, offset_ptr const& rhs) noexcept -> difference_type {
+        return lhs.get() - rhs.get();
+    }
+
+    // Comparison
+    friend auto operator==(offset_ptr const& lhs, offset_ptr const& rhs) noexcept -> bool {
+        return lhs.get() == rhs.get();
+    }
+    friend auto operator<=>(offset_ptr const& lhs, offset_ptr const& rhs) noexcept -> std::strong_ordering {
+        return std::compare_three_way{}(lhs.get(), rhs.get());
+    }
+    friend auto operator==(offset_ptr const& lhs, std::nullptr_t) noexcept -> bool { return !lhs; }
+  private:
+    // A pointer to its own second byte is never useful so that offset stands for null
+    static constexpr difference_type null_offset{1};
+
+    void set(T* ptr) noexcept {
+        offset_ = ptr ? static_cast<difference_type>(reinterpret_cast<std::uintptr_t>(ptr) -
+                                                     reinterpret_cast<std::uintptr_t>(this))
+                      : null_offset;
+    }
+
+    difference_type offset_{null_offset};
+};
+}
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <algorithm>
 #include <cstddef>
+#include <cstring>
 
 namespace ml {
 class pmr {
@@ -16,6 +18,11 @@ class pmr {
     auto extend(void* ptr, size_type old_bytes, size_type new_bytes, size_type alignment) -> void* {
         return do_extend(ptr, old_bytes, new_bytes, alignment);
     }
+    // Resizes the allocation and keeps its contents, which may be moved with a bitwise copy
+    // Only valid for trivially relocatable contents, the old block must not be used afterwards
+    auto reallocate(void* ptr, size_type old_bytes, size_type new_bytes, size_type alignment) -> void* {
+        return do_reallocate(ptr, old_bytes, new_bytes, alignment);
+    }
     // Comparison
     auto is_equal(pmr const& other) const noexcept -> bool { return do_is_equal(other); }
   private:
@@ -23,7 +30,19 @@ class pmr {
     virtual auto do_allocate(size_type n_bytes, size_type alignment) -> void* = 0;
     virtual void do_deallocate(void* ptr, size_type n_bytes, size_type alignment) = 0;
     virtual auto do_extend(void* ptr, size_type old_bytes, size_type new_bytes, size_type alignment) -> void* = 0;
+    // Extends then copies the contents if the block moved
+    virtual auto do_reallocate(void* ptr, size_type old_bytes, size_type new_bytes, size_type alignment) -> void*;
     // Comparison
     virtual auto do_is_equal(pmr const& other) const noexcept -> bool = 0;
 };
+
+// Allocation
+inline auto pmr::do_reallocate(void* ptr, size_type old_bytes, size_type new_bytes, size_type alignment) -> void* {
+    auto* new_ptr{do_extend(ptr, old_bytes, new_bytes, alignment)};
+    if (ptr && new_ptr != ptr) {
+        std::memcpy(new_ptr, ptr, std::min(old_bytes, new_bytes));
+        do_deallocate(ptr, old_bytes, alignment);
+    }
+    return new_ptr;
+}
 }
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+
+#include "pmr.hpp"
+
+namespace ml {
+// Exposes an ml::pmr to std::pmr containers
+class std_pmr_adapter : public std::pmr::memory_resource {
+  public:
+    explicit std_pmr_adapter(ml::pmr* upstream)
+        : upstream_{upstream} {}
+    ~std_pmr_adapter() override = default;
+
+    // Access
+    auto upstream() const -> ml::pmr* { return upstream_; }
+  protected:
+    auto do_allocate(std::size_t n_bytes, std::size_t alignment) -> void* override final {
+        return upstream_->allocate(n_bytes, alignment);
+    }
+    void do_deallocate(void* p, std::size_t n_bytes, std::size_t alignment) override final {
+        upstream_->deallocate(p, n_bytes, alignment);
+    }
+    auto do_is_equal(std::pmr::memory_resource const& other) const noexcept -> bool override final {
+        if (this == &other) {
+            return true;
+        }
+        auto const* adapter{dynamic_cast<std_pmr_adapter const*>(&other)};
+        return adapter && upstream_->is_equal(*adapter->upstream_);
+    }
+  private:
+    ml::pmr* upstream_{nullptr};
+};
+
+/*
+Exposes a std::pmr::memory_resource as an ml::pmr.
+
+If the upstream is also an ml::pmr (e.g. arena_pmr) extend is forwarded to it,
+otherwise extend always allocates a new block, even to shrink,
+since a std::pmr resource may need the original size back on deallocate.
+*/
+class ml_pmr_adapter : public ml::pmr {
+  public:
+    explicit ml_pmr_adapter(std::pmr::memory_resource* upstream)
+        : upstream_{upstream}
+        , extendable_upstream_{dynamic_cast<ml::pmr*>(upstream)} {}
+    ~ml_pmr_adapter() override = default;
+
+    // Access
+    auto upstream() const -> std::pmr::memory_resource* { return upstream_; }
+    auto can_extend() const -> bool { return extendable_upstream_ != nullptr; }
+  private:
+    auto do_allocate(size_type n_bytes, size_type alignment) -> void* override final {
+        return upstream_->allocate(n_bytes, alignment);
+    }
+    void do_deallocate(void* ptr, size_type n_bytes, size_type alignment) override final {
+        upstream_->deallocate(ptr, n_bytes, alignment);
+    }
+    auto do_extend(void* ptr, size_type old_bytes, size_type new_bytes, size_type alignment) -> void* override final {
+        if (extendable_upstream_) {
+            return extendable_upstream_->extend(ptr, old_bytes, new_bytes, alignment);
+        }
+        return upstream_->allocate(new_bytes, alignment);
+    }
+    auto do_is_equal(ml::pmr const& other) const noexcept -> bool override final {
+        if (this == &other) {
+            return true;
+        }
+        auto const* adapter{dynamic_cast<ml_pmr_adapter const*>(&other)};
+        return adapter && upstream_->is_equal(*adapter->upstream_);
+    }
+
+    std::pmr::memory_resource* upstream_{nullptr};
+    ml::pmr* extendable_upstream_{nullptr};
+};
+}
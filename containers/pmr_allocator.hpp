@@ -64,7 +64,7 @@ class pmr_allocator {
             return static_cast<T*>(
                 resource_->extend(ptr, old_elems * sizeof(T), new_elems * sizeof(T), alignof(T)));
         } else {
-            return resource_->allocate(new_elems * sizeof(T), alignof(T));
+            return static_cast<T*>(resource_->allocate(new_elems * sizeof(T), alignof(T)));
         }
     }
     auto extend_bytes(void* ptr, size_type old_bytes, size_type new_bytes, size_type alignment)
@@ -75,6 +75,18 @@ class pmr_allocator {
             return resource_->allocate(new_bytes, alignment);
         }
     }
+    // Reallocation, only for trivially relocatable T
+    auto reallocate(T* ptr, size_type old_elems, size_type new_elems) -> T*
+        requires reallocatable_memory_resource<ResourceT>
+    {
+        return static_cast<T*>(
+            resource_->reallocate(ptr, old_elems * sizeof(T), new_elems * sizeof(T), alignof(T)));
+    }
+    auto reallocate_bytes(void* ptr, size_type old_bytes, size_type new_bytes, size_type alignment) -> void*
+        requires reallocatable_memory_resource<ResourceT>
+    {
+        return resource_->reallocate(ptr, old_bytes, new_bytes, alignment);
+    }
 
     // Object construction/destruction
     template <class U, class... Args>
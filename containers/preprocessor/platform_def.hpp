@@ -1,4 +1,4 @@
-#pragma once
+// No include guard, platform_undef.hpp undoes this at the end of every header which includes it
 
 #ifdef _MSC_VER
 #if _MSC_VER >= 1929
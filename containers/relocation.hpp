@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace ml {
+/*
+Types whose objects can be moved to a new address by copying their bytes,
+after which the source is treated as destroyed without running its destructor.
+
+Trivially copyable types qualify. Specialise this for other types which don't point into themselves,
+e.g. a string which always keeps its characters on the heap.
+*/
+template <typename T>
+struct is_trivially_relocatable : std::bool_constant<std::is_trivially_copyable_v<T>> {};
+
+template <typename T>
+inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<std::remove_cv_t<T>>::value;
+
+// Moves n objects into uninitialised memory and destroys the originals
+// The ranges must not overlap
+template <typename T>
+void relocate(T* source, std::size_t n, T* dest) {
+    if constexpr (is_trivially_relocatable_v<T>) {
+        if (n) {
+            std::memcpy(static_cast<void*>(dest), static_cast<void const*>(source), n * sizeof(T));
+        }
+    } else {
+        for (std::size_t i{0}; i < n; ++i) {
+            new (dest + i) T(std::move(source[i]));
+            source[i].~T();
+        }
+    }
+}
+// Same as relocate but the ranges may overlap
+template <typename T>
+void relocate_overlapping(T* source, std::size_t n, T* dest) {
+    if constexpr (is_trivially_relocatable_v<T>) {
+        if (n) {
+            std::memmove(static_cast<void*>(dest), static_cast<void const*>(source), n * sizeof(T));
+        }
+    } else if (dest < source) {
+        relocate(source, n, dest);
+    } else {
+        for (std::size_t i{n}; i > 0; --i) {
+            new (dest + i - 1) T(std::move(source[i - 1]));
+            source[i - 1].~T();
+        }
+    }
+}
+// Copies n objects into uninitialised memory
+// The ranges must not overlap
+template <typename T>
+void copy_construct(T const* source, std::size_t n, T* dest) {
+    if constexpr (std::is_trivially_copyable_v<T>) {
+        if (n) {
+            std::memcpy(static_cast<void*>(dest), static_cast<void const*>(source), n * sizeof(T));
+        }
+    } else {
+        for (std::size_t i{0}; i < n; ++i) {
+            new (dest + i) T(source[i]);
+        }
+    }
+}
+}
@@ -1,4 +1,46 @@
 #pragma once
 
+#include <cstddef>
+#include <memory_resource>
+
+#include "pmr.hpp"
+
 namespace ml::pmr_mixins {
-}
\ No newline at end of file
+/*
+Base of resources usable as both a std::pmr::memory_resource and an ml::pmr.
+
+Both bases declare allocate, deallocate and is_equal so they are redeclared here to avoid ambiguity.
+The calls go straight to the final do_allocate, do_deallocate and do_extend of Derived,
+which override the functions of both bases. Derived befriends this class if those aren't public.
+Resources compare equal only to themselves.
+*/
+template <typename Derived>
+class dual_pmr
+    : public std::pmr::memory_resource
+    , public ml::pmr {
+  public:
+    using size_type = std::size_t;
+
+    // Allocation
+    [[nodiscard]] auto allocate(size_type n_bytes, size_type alignment = alignof(std::max_align_t)) -> void* {
+        return derived().do_allocate(n_bytes, alignment);
+    }
+    void deallocate(void* ptr, size_type n_bytes, size_type alignment = alignof(std::max_align_t)) {
+        derived().do_deallocate(ptr, n_bytes, alignment);
+    }
+    [[nodiscard]] auto extend(void* ptr, size_type old_bytes, size_type new_bytes, size_type alignment) -> void* {
+        return derived().do_extend(ptr, old_bytes, new_bytes, alignment);
+    }
+
+    // Comparison
+    using std::pmr::memory_resource::is_equal;
+    using ml::pmr::is_equal;
+  protected:
+    auto do_is_equal(std::pmr::memory_resource const& other) const noexcept -> bool override {
+        return this == &other;
+    }
+    auto do_is_equal(ml::pmr const& other) const noexcept -> bool override { return this == &other; }
+  private:
+    auto derived() -> Derived& { return static_cast<Derived&>(*this); }
+};
+}
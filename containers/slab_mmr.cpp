@@ -0,0 +1,60 @@
+#include <utility>
+
+#include "slab_mmr.hpp"
+
+namespace ml {
+slab_mmr::slab_mmr(size_type chunk_size)
+    : chunk_size_{std::max(chunk_size, max_block_size)} {}
+slab_mmr::~slab_mmr() {
+    release();
+}
+slab_mmr::slab_mmr(slab_mmr&& other) noexcept
+    : classes_{std::exchange(other.classes_, {})}
+    , owner_{other.owner_}
+    , chunks_{std::exchange(other.chunks_, {})}
+    , chunk_size_{other.chunk_size_} {
+    take_remote(other.remote_, remote_);
+}
+auto slab_mmr::operator=(slab_mmr&& other) noexcept -> slab_mmr& {
+    if (this != &other) {
+        release();
+        classes_ = std::exchange(other.classes_, {});
+        take_remote(other.remote_, remote_);
+        owner_ = other.owner_;
+        chunks_ = std::exchange(other.chunks_, {});
+        chunk_size_ = other.chunk_size_;
+    }
+    return *this;
+}
+
+void slab_mmr::release() {
+    for (auto* chunk : chunks_) {
+        ::operator delete(chunk, chunk_size_, std::align_val_t{max_block_size});
+    }
+    chunks_.clear();
+    classes_ = {};
+    for (auto& remote : remote_) {
+        remote.store(nullptr, std::memory_order_relaxed);
+    }
+}
+void slab_mmr::take_remote(remote_lists& from, remote_lists& to) {
+    for (size_type i{0}; i < n_size_classes; ++i) {
+        to[i].store(from[i].exchange(nullptr, std::memory_order_acquire), std::memory_order_relaxed);
+    }
+}
+
+auto slab_mmr::refill(size_class_state& state, size_type block) -> void* {
+    // Chunks are aligned to the largest block so every block is aligned to its own size
+    auto* chunk{static_cast<std::byte*>(::operator new(chunk_size_, std::align_val_t{max_block_size}))};
+    try {
+        chunks_.push_back(chunk);
+    } catch (...) {
+        ::operator delete(chunk, chunk_size_, std::align_val_t{max_block_size});
+        throw;
+    }
+
+    state.cursor = chunk + block;
+    state.end = chunk + (chunk_size_ / block) * block;
+    return chunk;
+}
+}
@@ -0,0 +1,195 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+#include "misc.hpp"
+
+namespace ml {
+/*
+Pool resource with power-of-two size classes for node-based containers.
+
+Small requests are rounded up to a size class and served from an intrusive free list.
+Free lists are refilled by carving blocks out of large chunks so allocate and deallocate are O(1).
+Chunks are only returned when the resource is destroyed or released.
+Requests larger than max_block_size go straight to operator new.
+
+Only the owning thread, by default the one which made the resource, may allocate from it.
+Any thread may deallocate. Frees from other threads are pushed onto lock-free per-class remote lists
+which the owner takes back a whole list at a time once its own free list runs dry.
+*/
+class slab_mmr {
+  public:
+    using size_type = std::size_t;
+
+    static constexpr size_type min_block_size{sizeof(void*)};
+    static constexpr size_type max_block_size{4096};
+    static constexpr size_type n_size_classes{
+        static_cast<size_type>(std::countr_zero(max_block_size) - std::countr_zero(min_block_size)) + 1};
+    static constexpr size_type default_chunk_size{size_type{1} << 16};
+
+    slab_mmr() = default;
+    explicit slab_mmr(size_type chunk_size);
+    ~slab_mmr();
+
+    slab_mmr(slab_mmr const&) = delete;
+    slab_mmr(slab_mmr&& other) noexcept;
+
+    auto operator=(slab_mmr const&) -> slab_mmr& = delete;
+    auto operator=(slab_mmr&& other) noexcept -> slab_mmr&;
+
+    // Capacity
+    auto chunk_size() const -> size_type;
+    auto n_chunks() const -> size_type;
+
+    // Ownership
+    // Whether the calling thread owns the resource
+    auto is_owner() const -> bool;
+    // Makes the calling thread the owner, e.g. after handing the resource to a worker
+    void claim();
+
+    // Allocation
+    [[nodiscard]] auto allocate(size_type n_bytes, size_type alignment) -> void*;
+    auto deallocate(void* ptr, size_type n_bytes, size_type alignment) -> void;
+    // Grows in place if the new size falls in the same size class
+    [[nodiscard]] auto extend(void* ptr, size_type old_bytes, size_type new_bytes, size_type alignment)
+        -> void*;
+    // Thread-safe deallocation for callers which know they aren't the owner
+    void deallocate_remote(void* ptr, size_type n_bytes, size_type alignment);
+    // Returns every chunk, all outstanding allocations become invalid
+    void release();
+
+    // Size classes
+    static auto block_size(size_type n_bytes, size_type alignment) -> size_type;
+    static auto size_class(size_type block) -> size_type;
+  private:
+    struct free_block {
+        free_block* next;
+    };
+    struct size_class_state {
+        free_block* free_list{nullptr};
+        std::byte* cursor{nullptr};
+        std::byte* end{nullptr};
+    };
+
+    using remote_lists = std::array<std::atomic<free_block*>, n_size_classes>;
+
+    auto refill(size_class_state& state, size_type block) -> void*;
+    static void take_remote(remote_lists& from, remote_lists& to);
+
+    std::array<size_class_state, n_size_classes> classes_{};
+    // Blocks freed by other threads, only ever pushed to or taken whole so there is no ABA problem
+    alignas(cache_line_size) remote_lists remote_{};
+    // Threads are numbered from a counter rather than by std::this_thread::get_id() or a thread_local's
+    // address, as both are reused once a thread exits and a later thread would pass as the owner
+    static inline std::atomic<std::uint64_t> next_thread_id_{1};
+    static inline thread_local std::uint64_t const thread_id_{next_thread_id_.fetch_add(1, std::memory_order_relaxed)};
+    std::uint64_t owner_{thread_id_};
+    std::vector<std::byte*> chunks_;
+    size_type chunk_size_{default_chunk_size};
+};
+
+// Capacity
+inline auto slab_mmr::chunk_size() const -> size_type {
+    return chunk_size_;
+}
+inline auto slab_mmr::n_chunks() const -> size_type {
+    return chunks_.size();
+}
+// Ownership
+inline auto slab_mmr::is_owner() const -> bool {
+    return owner_ == thread_id_;
+}
+inline void slab_mmr::claim() {
+    owner_ = thread_id_;
+}
+// Allocation
+inline auto slab_mmr::allocate(size_type n_bytes, size_type alignment) -> void* {
+    auto const block{block_size(n_bytes, alignment)};
+    if (block > max_block_size) {
+        return ::operator new(n_bytes, std::align_val_t{alignment});
+    }
+
+    auto const index{size_class(block)};
+    auto& state{classes_[index]};
+    if (auto* head{state.free_list}) {
+        state.free_list = head->next;
+        return head;
+    }
+    // Check before exchanging so the common case doesn't write to the shared cache line
+    if (auto& remote{remote_[index]}; remote.load(std::memory_order_relaxed)) {
+        auto* head{remote.exchange(nullptr, std::memory_order_acquire)};
+        state.free_list = head->next;
+        return head;
+    }
+    if (state.cursor != state.end) {
+        auto* ptr{state.cursor};
+        state.cursor += block;
+        return ptr;
+    }
+    return refill(state, block);
+}
+inline auto slab_mmr::deallocate(void* ptr, size_type n_bytes, size_type alignment) -> void {
+    if (!ptr) {
+        return;
+    }
+
+    if (!is_owner()) {
+        deallocate_remote(ptr, n_bytes, alignment);
+        return;
+    }
+
+    auto const block{block_size(n_bytes, alignment)};
+    if (block > max_block_size) {
+        ::operator delete(ptr, n_bytes, std::align_val_t{alignment});
+        return;
+    }
+
+    auto& state{classes_[size_class(block)]};
+    auto* node{static_cast<free_block*>(ptr)};
+    node->next = state.free_list;
+    state.free_list = node;
+}
+inline void slab_mmr::deallocate_remote(void* ptr, size_type n_bytes, size_type alignment) {
+    if (!ptr) {
+        return;
+    }
+
+    auto const block{block_size(n_bytes, alignment)};
+    if (block > max_block_size) {
+        ::operator delete(ptr, n_bytes, std::align_val_t{alignment});
+        return;
+    }
+
+    auto& remote{remote_[size_class(block)]};
+    auto* node{static_cast<free_block*>(ptr)};
+    node->next = remote.load(std::memory_order_relaxed);
+    while (!remote.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed)) {
+    }
+}
+inline auto slab_mmr::extend(void* ptr, size_type old_bytes, size_type new_bytes, size_type alignment)
+    -> void* {
+    if (!ptr) {
+        return allocate(new_bytes, alignment);
+    }
+
+    auto const old_block{block_size(old_bytes, alignment)};
+    if (old_block <= max_block_size && block_size(new_bytes, alignment) == old_block) {
+        return ptr;
+    }
+    return allocate(new_bytes, alignment);
+}
+// Size classes
+inline auto slab_mmr::block_size(size_type n_bytes, size_type alignment) -> size_type {
+    return std::bit_ceil(std::max({n_bytes, alignment, min_block_size}));
+}
+inline auto slab_mmr::size_class(size_type block) -> size_type {
+    return static_cast<size_type>(std::countr_zero(block) - std::countr_zero(min_block_size));
+}
+}
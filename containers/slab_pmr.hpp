@@ -0,0 +1,46 @@
+#pragma once
+
+#include "slab_mmr.hpp"
+
+namespace ml {
+template <typename resource_base>
+class slab_pmr : public resource_base {
+  public:
+    using size_type = std::size_t;
+
+    slab_pmr() = default;
+    explicit slab_pmr(size_type chunk_size)
+        : slab_{chunk_size} {}
+    ~slab_pmr() override = default;
+
+    slab_pmr(slab_pmr const&) = delete;
+    auto operator=(slab_pmr const&) -> slab_pmr& = delete;
+
+    auto do_allocate(size_type n_bytes, size_type alignment) -> void* override final {
+        return slab_.allocate(n_bytes, alignment);
+    }
+    void do_deallocate(void* ptr, size_type n_bytes, size_type alignment) override final {
+        slab_.deallocate(ptr, n_bytes, alignment);
+    }
+    virtual auto do_extend(void* ptr, size_type old_bytes, size_type new_bytes, size_type alignment) -> void* final {
+        return slab_.extend(ptr, old_bytes, new_bytes, alignment);
+    }
+    auto do_is_equal(resource_base const& other) const noexcept -> bool override final { return this == &other; }
+
+    // Thread-safe deallocation for callers which know they aren't the owner
+    void deallocate_remote(void* ptr, size_type n_bytes, size_type alignment) {
+        slab_.deallocate_remote(ptr, n_bytes, alignment);
+    }
+
+    // Ownership
+    auto is_owner() const -> bool { return slab_.is_owner(); }
+    // Makes the calling thread the owner, e.g. after handing the resource to a worker
+    void claim() { slab_.claim(); }
+
+    // Access
+    auto slab() const -> slab_mmr const& { return slab_; }
+    void release() { slab_.release(); }
+  private:
+    slab_mmr slab_;
+};
+}
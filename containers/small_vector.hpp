@@ -0,0 +1,213 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <ranges>
+#include <type_traits>
+
+#include "allocator_concepts.hpp"
+#include "contiguous_container_mixins.hpp"
+#include "dynamic_array_mixins.hpp"
+#include "iterator_boilerplate.hpp"
+#include "relocation.hpp"
+#include "span_iterator.hpp"
+#include "uninitialized_array.hpp"
+#include "vector.hpp"
+
+#include "preprocessor/platform_def.hpp"
+
+namespace ml {
+/*
+Dynamic array which keeps up to N elements inline.
+
+Short lists never touch the allocator. Once the inline slots run out the elements move
+to an allocated block, and shrink_to_fit moves them back if they fit again.
+Moving an inline small_vector moves its elements one by one, so iterators into it are invalidated.
+*/
+template <typename T,
+          std::size_t N,
+          typename Allocator = std::allocator<T>,
+          vector_growth_policy Growth = vector_growth_2x>
+class small_vector
+    : public ContiguousIteratorMethods
+    , public ContiguousContainerCommonMethods
+    , public ContiguousContainerCommonCapacityMethods
+    , public DynamicArrayModifierMethods {
+    friend struct ContiguousContainerCommonMethods;
+    friend struct ContiguousContainerCommonCapacityMethods;
+    friend struct DynamicArrayModifierMethods;
+  public:
+    using value_type = T;
+    using allocator_type = Allocator;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T&;
+    using const_reference = T const&;
+    using pointer = T*;
+    using const_pointer = T const*;
+    using iterator = span_iterator<T>;
+    using const_iterator = span_iterator<T const>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    static constexpr size_type inline_capacity{N};
+
+    // Ctor
+    // User-provided so value-initialisation doesn't zero the inline slots
+    small_vector() noexcept {}
+    small_vector(Allocator const& alloc)
+        : alloc{alloc} {}
+    template <std::input_iterator It, std::sentinel_for<It> Sentinel>
+    small_vector(It first, Sentinel last, Allocator const& alloc = Allocator())
+        : alloc{alloc} {
+        append_range(std::ranges::subrange(std::move(first), std::move(last)));
+    }
+    small_vector(std::initializer_list<T> values, Allocator const& alloc = Allocator())
+        : alloc{alloc} {
+        append_range(values);
+    }
+    // Copy ctor
+    small_vector(small_vector const& other)
+        : alloc{std::allocator_traits<Allocator>::select_on_container_copy_construction(other.alloc)} {
+        reserve(other.size_);
+        copy_construct(other.data_, other.size_, data_);
+        size_ = other.size_;
+    }
+    // Move ctor
+    small_vector(small_vector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+        : alloc{std::move(other.alloc)} {
+        take(other);
+    }
+    // Copy assignment
+    auto operator=(small_vector const& other) -> small_vector& {
+        if (this != &other) {
+            copy_elements_from(other);
+        }
+        return *this;
+    }
+    // Move assignment
+    auto operator=(small_vector&& other) -> small_vector& {
+        if (this == &other) {
+            return *this;
+        }
+
+        constexpr bool propagate{std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value};
+        if constexpr (!propagate) {
+            if (!(alloc == other.alloc)) {
+                move_elements_from(other);
+                return *this;
+            }
+        }
+
+        clear();
+        release();
+        if constexpr (propagate) {
+            alloc = std::move(other.alloc);
+        }
+        take(other);
+        return *this;
+    }
+    // Dtor
+    ~small_vector() {
+        clear();
+        release();
+    }
+
+    // Capacity
+    auto capacity(this small_vector const& self) -> size_type { return self.capacity_; }
+    auto max_size() const -> size_type { return std::numeric_limits<size_type>::max(); }
+    // Whether the elements are in the inline slots
+    auto is_inline(this small_vector const& self) -> bool { return self.data_ == self.buffer_.data(); }
+
+    void reserve(this small_vector& self, size_type new_capacity) {
+        if (new_capacity <= self.capacity_) {
+            return;
+        }
+        self.move_to(self.allocate_at_least(new_capacity));
+    }
+    // Moves the elements back inline if they fit, otherwise into a block which fits them exactly
+    void shrink_to_fit(this small_vector& self) {
+        if (self.is_inline() || self.size_ == self.capacity_) {
+            return;
+        }
+        self.compact();
+    }
+    // Moves allocated elements back inline if they fit, otherwise into a block which fits them exactly
+    void compact(this small_vector& self) {
+        if (self.is_inline()) {
+            return;
+        }
+        if (self.size_ <= N) {
+            self.move_to({self.buffer_.data(), N});
+        } else {
+            self.move_to({self.alloc.allocate(self.size_), self.size_});
+        }
+    }
+
+    // Modifiers
+    void clear(this small_vector& self) {
+        std::destroy_n(self.data_, self.size_);
+        self.size_ = 0;
+    }
+    void pop_back(this small_vector& self) {
+        --self.size_;
+        self.data_[self.size_].~T();
+    }
+  private:
+    uninitialized_array<T, N> buffer_;
+    T* data_{buffer_.data()};
+    size_type size_{0};
+    size_type capacity_{N};
+    NO_UNIQUE_ADDRESS Allocator alloc;
+
+    // Grows by the policy, or straight to min_capacity if that is larger
+    void grow_to(this small_vector& self, size_type min_capacity) {
+        if (min_capacity > self.capacity_) {
+            self.reserve(Growth.next_capacity(self.capacity_, min_capacity, sizeof(T)));
+        }
+    }
+    auto allocate_at_least(this small_vector& self, size_type n) -> allocation_result<T*> {
+        if constexpr (at_least_allocator<Allocator>) {
+            auto [ptr, count]{self.alloc.allocate_at_least(n)};
+            return {ptr, static_cast<size_type>(count)};
+        } else {
+            return {self.alloc.allocate(n), n};
+        }
+    }
+    // Relocates the elements into new storage, which is either allocated or the inline slots
+    void move_to(this small_vector& self, allocation_result<T*> storage) {
+        relocate(self.data_, self.size_, storage.ptr);
+        self.release();
+        self.data_ = storage.ptr;
+        self.capacity_ = storage.count;
+    }
+    // Frees the allocated block, if any, without touching the elements
+    void release(this small_vector& self) {
+        if (!self.is_inline()) {
+            self.alloc.deallocate(self.data_, self.capacity_);
+            self.data_ = self.buffer_.data();
+            self.capacity_ = N;
+        }
+    }
+    // Takes the elements of a small_vector with an equal allocator, leaving it empty and inline
+    void take(this small_vector& self, small_vector& other) {
+        if (other.is_inline()) {
+            relocate(other.data_, other.size_, self.data_);
+        } else {
+            self.data_ = other.data_;
+            self.capacity_ = other.capacity_;
+            other.data_ = other.buffer_.data();
+            other.capacity_ = N;
+        }
+        self.size_ = other.size_;
+        other.size_ = 0;
+    }
+};
+}
+
+#include "preprocessor/platform_undef.hpp"
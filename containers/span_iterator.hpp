@@ -2,6 +2,7 @@
 
 #include <cstddef>
 #include <iterator>
+#include <type_traits>
 
 namespace ml {
 template <typename T>
@@ -19,6 +20,12 @@ class span_iterator {
     explicit span_iterator(T* ptr) noexcept
         : ptr_(ptr) {}
 
+    // iterator to const_iterator
+    template <typename U>
+        requires std::is_convertible_v<U*, T*>
+    span_iterator(span_iterator<U> const& other) noexcept
+        : ptr_(other.operator->()) {}
+
     span_iterator(span_iterator const&) noexcept = default;
     span_iterator(span_iterator&&) noexcept = default;
 
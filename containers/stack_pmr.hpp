@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <memory_resource>
@@ -8,34 +9,74 @@
 #include <utility>
 #include <memory>
 
+#include "pmr.hpp"
+#include "resource_mixins.hpp"
+
 namespace ml {
 using stack_frame_id = uint16_t;
 class stack_pmr_frame;
 
 using unique_frame_ptr = std::unique_ptr<stack_pmr_frame, void (*)(stack_pmr_frame*)>;
 
+// A block of stack memory, the data follows the header
+struct alignas(std::max_align_t) stack_pmr_segment {
+    stack_pmr_segment* next{nullptr};
+    std::size_t capacity{0};
+
+    auto data() -> std::byte* { return reinterpret_cast<std::byte*>(this + 1); }
+};
+
+// Position of the top of the stack
+struct stack_pmr_position {
+    stack_pmr_segment* segment{nullptr};
+    std::size_t size{0};
+    // Bytes used in the segments before segment
+    std::size_t prior_size{0};
+};
+
+/*
+Stack of memory frames.
+
+reserve() sets up the first segment.
+When a segment overflows another one is chained from the upstream resource, twice as large or big enough
+for the request. Popping a frame rewinds across segments and keeps the spare segments for later frames.
+*/
 class stack_pmr {
   public:
     using size_type = std::size_t;
 
+    // Size of the first segment if reserve() wasn't called
+    static constexpr size_type default_segment_size{4096};
+
     stack_pmr() = default;
-    ~stack_pmr() = default;
+    explicit stack_pmr(std::pmr::memory_resource* upstream);
+    ~stack_pmr();
+
+    // Frames point back to the stack so it can't be moved
+    stack_pmr(stack_pmr const&) = delete;
+    stack_pmr(stack_pmr&&) = delete;
+
+    auto operator=(stack_pmr const&) -> stack_pmr& = delete;
+    auto operator=(stack_pmr&&) -> stack_pmr& = delete;
+
+    // Access
+    auto upstream() const -> std::pmr::memory_resource* { return upstream_; }
+    auto position() const -> stack_pmr_position { return {segment_, size_, prior_size_}; }
 
     // Capacity
-    template <typename Self>
-    auto buffer(this Self&& self) {
-        return std::forward<Self>(self).buffer_;
-    }
-    auto empty() const -> bool { return size_ == 0; }
-    auto size() const { return size_; }
-    auto capacity() const { return capacity_; }
-    auto remaining_capacity() const { return capacity() - size(); }
+    auto empty() const -> bool { return size() == 0; }
+    auto size() const -> size_type { return prior_size_ + size_; }
+    // Total capacity of every segment, including spare ones
+    auto capacity() const -> size_type { return capacity_; }
+    // Bytes left in the current segment
+    auto remaining_capacity() const -> size_type { return segment_ ? segment_->capacity - size_ : 0; }
+    auto n_segments() const -> size_type { return n_segments_; }
     void reserve(size_type n) {
-        if (buffer_) {
+        if (first_) {
             throw std::runtime_error("Buffer already reserved.");
         }
-        buffer_ = std::make_unique<std::byte[]>(n);
-        capacity_ = n;
+        first_ = create_segment(n);
+        segment_ = first_;
     }
 
     // Frames
@@ -50,36 +91,77 @@ class stack_pmr {
         }
         return allocate(n_bytes, alignment);
     }
+    // Reclaims the allocation if it is the most recent one of the current frame
+    void deallocate(stack_pmr_frame* frame, void* ptr, size_type n_bytes) {
+        if (frame == current_ && is_top(ptr, n_bytes)) {
+            size_ = static_cast<size_type>(static_cast<std::byte*>(ptr) - segment_->data());
+        }
+    }
+    // Grows or shrinks the most recent allocation in place if the current segment has room
+    [[nodiscard]] auto extend(stack_pmr_frame* frame, void* ptr, size_type old_bytes, size_type new_bytes, size_type alignment)
+        -> void* {
+        if (frame != current_) {
+            throw std::runtime_error("Non-current frame tried to allocate.");
+        }
+        if (!ptr) {
+            return allocate(new_bytes, alignment);
+        }
+        if (is_top(ptr, old_bytes)) {
+            if (new_bytes <= old_bytes || new_bytes - old_bytes <= remaining_capacity()) {
+                size_ = size_ - old_bytes + new_bytes;
+                return ptr;
+            }
+        } else if (new_bytes <= old_bytes) {
+            return ptr;
+        }
+        return allocate(new_bytes, alignment);
+    }
   private:
+    auto is_top(void* ptr, size_type n_bytes) const -> bool {
+        return segment_ && static_cast<std::byte*>(ptr) + n_bytes == segment_->data() + size_;
+    }
     [[nodiscard]] auto allocate(size_type n_bytes, size_type alignment) -> void* {
-        auto const cur_size{size_};
-        auto remaining{remaining_capacity()};
-
-        auto* new_start{static_cast<void*>(buffer_.get() + cur_size)};
-        if (!std::align(alignment, n_bytes, new_start, remaining)) {
-            throw std::bad_alloc{};
+        if (segment_) {
+            auto remaining{remaining_capacity()};
+            auto* new_start{static_cast<void*>(segment_->data() + size_)};
+            if (std::align(alignment, n_bytes, new_start, remaining)) {
+                size_ = (segment_->capacity - remaining) + n_bytes;
+                return new_start;
+            }
         }
-
-        size_ = (capacity_ - remaining) + n_bytes;
-        return new_start;
+        return allocate_from_next_segment(n_bytes, alignment);
     }
+    // Moves to the next spare segment or chains a new one
+    auto allocate_from_next_segment(size_type n_bytes, size_type alignment) -> void*;
+    auto create_segment(size_type capacity) -> stack_pmr_segment*;
+    void rewind(stack_pmr_position const& position);
 
-    std::unique_ptr<std::byte[]> buffer_{nullptr};
+    std::pmr::memory_resource* upstream_{std::pmr::new_delete_resource()};
+    stack_pmr_segment* first_{nullptr};
+    stack_pmr_segment* segment_{nullptr};
     size_type size_{0};
+    size_type prior_size_{0};
     size_type capacity_{0};
+    size_type n_segments_{0};
     stack_pmr_frame* current_{nullptr};
 };
 
-class stack_pmr_frame : public std::pmr::memory_resource {
+/*
+A frame of a stack_pmr, usable as both a std::pmr::memory_resource and an ml::pmr.
+
+Freeing the most recent allocation gives its memory back and the most recent allocation
+can be extended in place. Anything else is released when the frame is popped.
+*/
+class stack_pmr_frame : public pmr_mixins::dual_pmr<stack_pmr_frame> {
   public:
     using size_type = std::size_t;
     friend class stack_pmr;
 
     stack_pmr_frame() = delete;
-    stack_pmr_frame(stack_pmr* stack, stack_pmr_frame* previous, size_type previous_size)
+    stack_pmr_frame(stack_pmr* stack, stack_pmr_frame* previous, stack_pmr_position previous_position)
         : stack_{stack}
         , previous_{previous}
-        , previous_size_{previous_size} {}
+        , previous_position_{previous_position} {}
 
     ~stack_pmr_frame() override {
         if (stack_) {
@@ -96,23 +178,34 @@ class stack_pmr_frame : public std::pmr::memory_resource {
     auto do_allocate(size_type n_bytes, size_type alignment) -> void* override final {
         return stack_->allocate(this, n_bytes, alignment);
     }
-    void do_deallocate(void* /*ptr*/,
-                       size_type /*n_bytes*/,
-                       size_type /*alignment*/) override final {
-        return;
+    void do_deallocate(void* ptr, size_type n_bytes, size_type /*alignment*/) override final {
+        stack_->deallocate(this, ptr, n_bytes);
     }
-    auto do_is_equal(std::pmr::memory_resource const& other) const noexcept -> bool override final {
-        return this == &other;
+    auto do_extend(void* ptr, size_type old_bytes, size_type new_bytes, size_type alignment) -> void* override final {
+        return stack_->extend(this, ptr, old_bytes, new_bytes, alignment);
     }
   private:
     stack_pmr* stack_{nullptr};
     stack_pmr_frame* previous_{nullptr};
-    size_type previous_size_{0};
+    stack_pmr_position previous_position_{};
 };
+
+// Ctor
+inline stack_pmr::stack_pmr(std::pmr::memory_resource* upstream)
+    : upstream_{upstream} {}
+inline stack_pmr::~stack_pmr() {
+    auto* segment{first_};
+    while (segment) {
+        auto* next{segment->next};
+        upstream_->deallocate(segment, sizeof(stack_pmr_segment) + segment->capacity, alignof(stack_pmr_segment));
+        segment = next;
+    }
+}
+// Frames
 inline auto stack_pmr::create_frame() -> unique_frame_ptr {
-    auto old_size{size()};
+    auto const old_position{position()};
     void* frame_address{allocate(sizeof(stack_pmr_frame), alignof(stack_pmr_frame))};
-    auto* frame{new (frame_address) stack_pmr_frame{this, current_, old_size}};
+    auto* frame{new (frame_address) stack_pmr_frame{this, current_, old_position}};
     current_ = frame;
     return unique_frame_ptr{frame, [](stack_pmr_frame* frame) { frame->~stack_pmr_frame(); }};
 }
@@ -125,7 +218,51 @@ inline void stack_pmr::pop_frame(stack_pmr_frame* frame) {
     }
 
     current_ = frame->previous_;
-    size_ = frame->previous_size_;
+    rewind(frame->previous_position_);
     return;
 }
+// Allocation
+inline auto stack_pmr::allocate_from_next_segment(size_type n_bytes, size_type alignment) -> void* {
+    // Leave room for the worst-case alignment padding
+    auto const bytes_needed{n_bytes + alignment};
+
+    if (!segment_) {
+        first_ = create_segment(std::max(default_segment_size, bytes_needed));
+        segment_ = first_;
+    } else if (auto* next{segment_->next}; next && next->capacity >= bytes_needed) {
+        prior_size_ += size_;
+        segment_ = next;
+    } else {
+        auto* fresh{create_segment(std::max(segment_->capacity * 2, bytes_needed))};
+        fresh->next = segment_->next;
+        segment_->next = fresh;
+        prior_size_ += size_;
+        segment_ = fresh;
+    }
+    size_ = 0;
+
+    auto remaining{remaining_capacity()};
+    auto* new_start{static_cast<void*>(segment_->data())};
+    (void)std::align(alignment, n_bytes, new_start, remaining);
+    size_ = (segment_->capacity - remaining) + n_bytes;
+    return new_start;
+}
+inline auto stack_pmr::create_segment(size_type capacity) -> stack_pmr_segment* {
+    auto* buffer{upstream_->allocate(sizeof(stack_pmr_segment) + capacity, alignof(stack_pmr_segment))};
+    auto* segment{new (buffer) stack_pmr_segment{nullptr, capacity}};
+    capacity_ += capacity;
+    ++n_segments_;
+    return segment;
+}
+inline void stack_pmr::rewind(stack_pmr_position const& position) {
+    if (position.segment) {
+        segment_ = position.segment;
+        size_ = position.size;
+        prior_size_ = position.prior_size;
+    } else {
+        segment_ = first_;
+        size_ = 0;
+        prior_size_ = 0;
+    }
+}
 }
@@ -1,12 +1,12 @@
 #pragma once
 
-#include <array>
 #include <cstddef>
 #include <stdexcept>
 
 #include "contiguous_container_mixins.hpp"
 #include "iterator_boilerplate.hpp"
 #include "span_iterator.hpp"
+#include "uninitialized_array.hpp"
 
 namespace ml {
 template <typename T, std::size_t CAPACITY>
@@ -17,13 +17,6 @@ class static_vector
   private:
     friend struct ContiguousContainerCommonMethods;
     friend struct ContiguousContainerCommonCapacityMethods;
-
-    union array_elem_t {
-        T value;
-
-        array_elem_t() {}
-        ~array_elem_t() {}
-    };
   public:
     using value_type = T;
     using size_type = std::size_t;
@@ -55,14 +48,14 @@ class static_vector
     template <typename U>
     void push_back(U&& value);
   private:
-    std::array<array_elem_t, CAPACITY> data_;
+    uninitialized_array<T, CAPACITY> data_;
     size_type size_{0};
 };
 
 template <typename T, std::size_t CAPACITY>
 inline static_vector<T, CAPACITY>::~static_vector() {
     for (size_type i{0}; i < size_; ++i) {
-        data_[i].value.~T();
+        data()[i].~T();
     }
 }
 
@@ -70,8 +63,7 @@ inline static_vector<T, CAPACITY>::~static_vector() {
 template <typename T, std::size_t CAPACITY>
 template <typename Self>
 inline auto* static_vector<T, CAPACITY>::data(this Self&& self) {
-    using ptr_t = std::conditional_t<std::is_const_v<std::remove_reference_t<Self>>, T const*, T*>;
-    return reinterpret_cast<ptr_t>(std::forward<Self>(self).data_.data());
+    return std::forward<Self>(self).data_.data();
 }
 
 // Capacity
@@ -83,7 +75,7 @@ inline constexpr auto static_vector<T, CAPACITY>::capacity() const -> size_type
 template <typename T, std::size_t CAPACITY>
 inline void static_vector<T, CAPACITY>::clear() {
     for (size_type i{0}; i < size_; ++i) {
-        data_[i].value.~T();
+        data()[i].~T();
     }
     size_ = 0;
 }
@@ -93,7 +85,7 @@ inline void static_vector<T, CAPACITY>::emplace_back(Args&&... args) {
     if (size_ >= CAPACITY) {
         throw std::out_of_range{"static_vector: push_back: out of range"};
     }
-    new (&data_[size_].value) T{std::forward<Args>(args)...};
+    new (data() + size_) T{std::forward<Args>(args)...};
     ++size_;
 }
 template <typename T, std::size_t CAPACITY>
@@ -102,7 +94,7 @@ inline void static_vector<T, CAPACITY>::pop_back() {
         throw std::out_of_range{"static_vector: pop_back: out of range"};
     }
     --size_;
-    data_[size_].value.~T();
+    data()[size_].~T();
 }
 template <typename T, std::size_t CAPACITY>
 template <typename U>
@@ -110,7 +102,7 @@ void static_vector<T, CAPACITY>::push_back(U&& value) {
     if (size_ >= CAPACITY) {
         throw std::out_of_range{"static_vector: push_back: out of range"};
     }
-    new (&data_[size_].value) T{std::forward<U>(value)};
+    new (data() + size_) T{std::forward<U>(value)};
     ++size_;
 }
 }
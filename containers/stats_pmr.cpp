@@ -0,0 +1,43 @@
+#include "stats_pmr.hpp"
+
+namespace ml {
+auto stats_pmr::stats() const -> allocation_stats {
+    auto load{[](counter const& c) { return c.load(std::memory_order_relaxed); }};
+
+    allocation_stats out;
+    out.n_allocations = load(n_allocations_);
+    out.n_deallocations = load(n_deallocations_);
+    out.live_bytes = load(live_bytes_);
+    out.peak_bytes = load(peak_bytes_);
+    out.n_extends = load(n_extends_);
+    out.n_extends_in_place = load(n_extends_in_place_);
+    out.n_extends_fallback = load(n_extends_fallback_);
+    out.padding_bytes = load(padding_bytes_);
+    for (std::size_t i{0}; i < allocation_stats::n_size_buckets; ++i) {
+        out.size_histogram[i] = load(size_histogram_[i]);
+    }
+    for (std::size_t i{0}; i < allocation_stats::n_alignment_buckets; ++i) {
+        out.alignment_histogram[i] = load(alignment_histogram_[i]);
+    }
+    return out;
+}
+void stats_pmr::reset_stats() {
+    auto clear{[](counter& c) { c.store(0, std::memory_order_relaxed); }};
+
+    clear(n_allocations_);
+    clear(n_deallocations_);
+    // Live bytes are kept as the allocations are still outstanding
+    peak_bytes_.store(live_bytes_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    clear(n_extends_);
+    clear(n_extends_in_place_);
+    clear(n_extends_fallback_);
+    clear(padding_bytes_);
+    for (auto& c : size_histogram_) {
+        clear(c);
+    }
+    for (auto& c : alignment_histogram_) {
+        clear(c);
+    }
+    last_end_.store(0, std::memory_order_relaxed);
+}
+}
@@ -0,0 +1,239 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <optional>
+
+#include "pmr.hpp"
+#include "pmr_adapters.hpp"
+#include "resource_mixins.hpp"
+
+namespace ml {
+// Point-in-time copy of the counters of a stats_pmr
+struct allocation_stats {
+    using size_type = std::size_t;
+
+    // Bucket i counts sizes in [2^(i-1), 2^i), the last bucket takes everything larger
+    static constexpr size_type n_size_buckets{32};
+    // Bucket i counts alignments of 2^i
+    static constexpr size_type n_alignment_buckets{16};
+
+    size_type n_allocations{0};
+    size_type n_deallocations{0};
+    size_type live_bytes{0};
+    size_type peak_bytes{0};
+    size_type n_extends{0};
+    size_type n_extends_in_place{0};
+    size_type n_extends_fallback{0};
+    size_type padding_bytes{0};
+    std::array<size_type, n_size_buckets> size_histogram{};
+    std::array<size_type, n_alignment_buckets> alignment_histogram{};
+
+    auto extend_hit_rate() const -> double {
+        return n_extends ? static_cast<double>(n_extends_in_place) / static_cast<double>(n_extends) : 0.0;
+    }
+};
+
+enum class stats_mode {
+    // Counters are updated with relaxed loads and stores, updates from other threads may be lost
+    single_thread,
+    // Counters are updated with relaxed read-modify-writes
+    multi_thread
+};
+
+/*
+Forwards to an upstream resource and counts what passes through.
+
+Usable as both a std::pmr::memory_resource and an ml::pmr.
+Counters are relaxed atomics so a snapshot can be taken from any thread.
+In multi_thread mode the wrapper can be shared between threads,
+a snapshot taken while other threads allocate is not guaranteed to be consistent.
+single_thread mode avoids the locked instructions and costs a few plain stores per call.
+
+Padding is estimated as the gap between the end of the previous allocation and the start of the next
+when the gap is smaller than the requested alignment. This is exact for single-threaded bump allocators.
+*/
+class stats_pmr : public pmr_mixins::dual_pmr<stats_pmr> {
+    friend class pmr_mixins::dual_pmr<stats_pmr>;
+  public:
+    using size_type = std::size_t;
+
+    explicit stats_pmr(ml::pmr* upstream, stats_mode mode = stats_mode::multi_thread);
+    // Extend is forwarded if the upstream is also an ml::pmr
+    explicit stats_pmr(std::pmr::memory_resource* upstream, stats_mode mode = stats_mode::multi_thread);
+    ~stats_pmr() override = default;
+
+    stats_pmr(stats_pmr const&) = delete;
+    stats_pmr(stats_pmr&&) = delete;
+
+    auto operator=(stats_pmr const&) -> stats_pmr& = delete;
+    auto operator=(stats_pmr&&) -> stats_pmr& = delete;
+
+    // Access
+    auto upstream() const -> ml::pmr*;
+    auto mode() const -> stats_mode;
+    auto stats() const -> allocation_stats;
+    void reset_stats();
+  protected:
+    auto do_allocate(std::size_t n_bytes, std::size_t alignment) -> void* override final;
+    void do_deallocate(void* p, std::size_t n_bytes, std::size_t alignment) override final;
+    auto do_extend(void* ptr, std::size_t old_bytes, std::size_t new_bytes, std::size_t alignment)
+        -> void* override final;
+    // Counted as an extend, plus a deallocation of the old block when it moved
+    auto do_reallocate(void* ptr, std::size_t old_bytes, std::size_t new_bytes, std::size_t alignment)
+        -> void* override final;
+  private:
+    using counter = std::atomic<size_type>;
+
+    void record_allocation(void* ptr, size_type n_bytes, size_type alignment);
+    void record_extend(void* ptr, void* new_ptr, size_type old_bytes, size_type new_bytes, size_type alignment);
+    void add_live_bytes(size_type n_bytes);
+    void bump(counter& c, size_type n = 1);
+    void drop(counter& c, size_type n);
+    auto swap_last_end(std::uintptr_t new_end) -> std::uintptr_t;
+
+    std::optional<ml_pmr_adapter> adapter_;
+    ml::pmr* upstream_{nullptr};
+    stats_mode mode_{stats_mode::multi_thread};
+
+    counter n_allocations_{0};
+    counter n_deallocations_{0};
+    counter live_bytes_{0};
+    counter peak_bytes_{0};
+    counter n_extends_{0};
+    counter n_extends_in_place_{0};
+    counter n_extends_fallback_{0};
+    counter padding_bytes_{0};
+    std::atomic<std::uintptr_t> last_end_{0};
+    std::array<counter, allocation_stats::n_size_buckets> size_histogram_{};
+    std::array<counter, allocation_stats::n_alignment_buckets> alignment_histogram_{};
+};
+
+// Ctor
+inline stats_pmr::stats_pmr(ml::pmr* upstream, stats_mode mode)
+    : upstream_{upstream}
+    , mode_{mode} {}
+inline stats_pmr::stats_pmr(std::pmr::memory_resource* upstream, stats_mode mode)
+    : adapter_{std::in_place, upstream}
+    , upstream_{&*adapter_}
+    , mode_{mode} {}
+// Access
+inline auto stats_pmr::upstream() const -> ml::pmr* {
+    return upstream_;
+}
+inline auto stats_pmr::mode() const -> stats_mode {
+    return mode_;
+}
+// Methods
+inline auto stats_pmr::do_allocate(std::size_t n_bytes, std::size_t alignment) -> void* {
+    auto* ptr{upstream_->allocate(n_bytes, alignment)};
+    record_allocation(ptr, n_bytes, alignment);
+    return ptr;
+}
+inline void stats_pmr::do_deallocate(void* p, std::size_t n_bytes, std::size_t alignment) {
+    upstream_->deallocate(p, n_bytes, alignment);
+    bump(n_deallocations_);
+    drop(live_bytes_, n_bytes);
+}
+inline auto stats_pmr::do_extend(void* ptr, std::size_t old_bytes, std::size_t new_bytes, std::size_t alignment)
+    -> void* {
+    auto* new_ptr{upstream_->extend(ptr, old_bytes, new_bytes, alignment)};
+    record_extend(ptr, new_ptr, old_bytes, new_bytes, alignment);
+    return new_ptr;
+}
+inline auto stats_pmr::do_reallocate(void* ptr, std::size_t old_bytes, std::size_t new_bytes, std::size_t alignment)
+    -> void* {
+    auto* new_ptr{upstream_->reallocate(ptr, old_bytes, new_bytes, alignment)};
+    record_extend(ptr, new_ptr, old_bytes, new_bytes, alignment);
+    if (ptr && new_ptr != ptr) {
+        bump(n_deallocations_);
+        drop(live_bytes_, old_bytes);
+    }
+    return new_ptr;
+}
+// Counters
+inline void stats_pmr::record_allocation(void* ptr, size_type n_bytes, size_type alignment) {
+    bump(n_allocations_);
+    add_live_bytes(n_bytes);
+
+    auto const size_bucket{std::min<size_type>(std::bit_width(n_bytes), allocation_stats::n_size_buckets - 1)};
+    auto const alignment_bucket{std::min<size_type>(static_cast<size_type>(std::countr_zero(alignment)),
+                                                    allocation_stats::n_alignment_buckets - 1)};
+    bump(size_histogram_[size_bucket]);
+    bump(alignment_histogram_[alignment_bucket]);
+
+    auto const start{reinterpret_cast<std::uintptr_t>(ptr)};
+    auto const previous_end{swap_last_end(start + n_bytes)};
+    if (previous_end && start > previous_end && start - previous_end < alignment) {
+        bump(padding_bytes_, start - previous_end);
+    }
+}
+inline void stats_pmr::record_extend(void* ptr,
+                                     void* new_ptr,
+                                     size_type old_bytes,
+                                     size_type new_bytes,
+                                     size_type alignment) {
+    if (!ptr) {
+        // Extending nothing is a plain allocation
+        record_allocation(new_ptr, new_bytes, alignment);
+        return;
+    }
+    bump(n_extends_);
+
+    if (new_ptr == ptr) {
+        bump(n_extends_in_place_);
+        // The caller deallocates with the new size so a shrink gives the tail back now
+        if (new_bytes > old_bytes) {
+            add_live_bytes(new_bytes - old_bytes);
+        } else {
+            drop(live_bytes_, old_bytes - new_bytes);
+        }
+        (void)swap_last_end(reinterpret_cast<std::uintptr_t>(ptr) + new_bytes);
+    } else {
+        // The old block is deallocated separately so this counts as a fresh allocation
+        bump(n_extends_fallback_);
+        record_allocation(new_ptr, new_bytes, alignment);
+    }
+}
+inline void stats_pmr::add_live_bytes(size_type n_bytes) {
+    auto peak{peak_bytes_.load(std::memory_order_relaxed)};
+    if (mode_ == stats_mode::single_thread) {
+        auto const live{live_bytes_.load(std::memory_order_relaxed) + n_bytes};
+        live_bytes_.store(live, std::memory_order_relaxed);
+        if (live > peak) {
+            peak_bytes_.store(live, std::memory_order_relaxed);
+        }
+        return;
+    }
+
+    auto const live{live_bytes_.fetch_add(n_bytes, std::memory_order_relaxed) + n_bytes};
+    while (live > peak && !peak_bytes_.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+}
+inline void stats_pmr::bump(counter& c, size_type n) {
+    if (mode_ == stats_mode::single_thread) {
+        c.store(c.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    } else {
+        c.fetch_add(n, std::memory_order_relaxed);
+    }
+}
+inline void stats_pmr::drop(counter& c, size_type n) {
+    if (mode_ == stats_mode::single_thread) {
+        c.store(c.load(std::memory_order_relaxed) - n, std::memory_order_relaxed);
+    } else {
+        c.fetch_sub(n, std::memory_order_relaxed);
+    }
+}
+inline auto stats_pmr::swap_last_end(std::uintptr_t new_end) -> std::uintptr_t {
+    if (mode_ == stats_mode::single_thread) {
+        auto const previous{last_end_.load(std::memory_order_relaxed)};
+        last_end_.store(new_end, std::memory_order_relaxed);
+        return previous;
+    }
+    return last_end_.exchange(new_end, std::memory_order_relaxed);
+}
+}
@@ -0,0 +1,164 @@
+#include <atomic>
+
+#include "thread_cache_pmr.hpp"
+
+namespace ml {
+namespace {
+std::atomic<std::size_t> next_instance_id{1};
+
+// Flushes the magazines of every resource the thread used when it exits
+// The magazines are owned by the shared state so they outlive the entries which point at them
+template <typename SharedState, typename Magazines>
+struct thread_bindings {
+    struct entry {
+        std::size_t id{0};
+        Magazines* magazines{nullptr};
+        std::weak_ptr<SharedState> state;
+    };
+
+    ~thread_bindings() {
+        for (auto& e : entries) {
+            if (auto state{e.state.lock()}) {
+                state->flush_all(*e.magazines);
+            }
+        }
+    }
+
+    std::vector<entry> entries;
+};
+}
+
+// Shared state
+thread_cache_pmr::shared_state::shared_state(ml::pmr* upstream_, thread_cache_options const& options_)
+    : upstream{upstream_}
+    , options{options_}
+    , id{next_instance_id.fetch_add(1, std::memory_order_relaxed)} {}
+thread_cache_pmr::shared_state::~shared_state() {
+    // Threads which are still running hold cached blocks too
+    // No thread can lock the state any more so none of them touches its magazines
+    for (auto& magazines : threads) {
+        for (size_type i{0}; i < n_size_classes; ++i) {
+            auto& m{magazines->classes[i]};
+            release_to_upstream(m.head, i);
+            m = {};
+        }
+    }
+    for (size_type i{0}; i < n_size_classes; ++i) {
+        release_to_upstream(lists[i].head, i);
+    }
+}
+void thread_cache_pmr::shared_state::refill(magazine& m, size_type size_class) {
+    auto const n{options.batch_size ? options.batch_size : 1};
+    {
+        auto& list{lists[size_class]};
+        std::scoped_lock lock{list.mutex};
+        while (list.head && m.size < n) {
+            auto* node{list.head};
+            list.head = node->next;
+            --list.size;
+            node->next = m.head;
+            m.head = node;
+            ++m.size;
+        }
+    }
+
+    auto const block{slab_mmr::min_block_size << size_class};
+    while (m.size < n) {
+        m.head = new (upstream->allocate(block, block_alignment(block))) free_block{m.head};
+        ++m.size;
+    }
+}
+void thread_cache_pmr::shared_state::flush(magazine& m, size_type size_class, size_type n) {
+    // Detach the first n blocks
+    free_block* first{m.head};
+    free_block* last{nullptr};
+    size_type n_moved{0};
+    for (auto* node{m.head}; node && n_moved < n; node = node->next) {
+        last = node;
+        ++n_moved;
+    }
+    if (!last) {
+        return;
+    }
+    m.head = last->next;
+    m.size -= n_moved;
+
+    free_block* surplus{nullptr};
+    {
+        auto& list{lists[size_class]};
+        std::scoped_lock lock{list.mutex};
+        last->next = list.head;
+        list.head = first;
+        list.size += n_moved;
+
+        // Keep the list within its capacity, the surplus is freed outside the lock
+        if (list.size > options.shared_capacity) {
+            auto n_surplus{list.size - options.shared_capacity};
+            surplus = list.head;
+            auto* tail{list.head};
+            for (size_type i{1}; i < n_surplus; ++i) {
+                tail = tail->next;
+            }
+            list.head = tail->next;
+            tail->next = nullptr;
+            list.size -= n_surplus;
+        }
+    }
+    release_to_upstream(surplus, size_class);
+}
+void thread_cache_pmr::shared_state::flush_all(thread_magazines& magazines) {
+    for (size_type i{0}; i < n_size_classes; ++i) {
+        auto& m{magazines.classes[i]};
+        flush(m, i, m.size);
+    }
+
+    std::scoped_lock lock{threads_mutex};
+    std::erase_if(threads, [&magazines](auto const& t) { return t.get() == &magazines; });
+}
+auto thread_cache_pmr::shared_state::add_thread() -> thread_magazines& {
+    std::scoped_lock lock{threads_mutex};
+    return *threads.emplace_back(std::make_unique<thread_magazines>());
+}
+void thread_cache_pmr::shared_state::release_to_upstream(free_block* head, size_type size_class) {
+    auto const block{slab_mmr::min_block_size << size_class};
+    while (head) {
+        auto* next{head->next};
+        upstream->deallocate(head, block, block_alignment(block));
+        head = next;
+    }
+}
+
+// Ctor
+thread_cache_pmr::thread_cache_pmr(ml::pmr* upstream, thread_cache_options const& options)
+    : state_{std::make_shared<shared_state>(upstream, options)} {}
+// Access
+auto thread_cache_pmr::n_thread_cached(size_type block) -> size_type {
+    return local().classes[slab_mmr::size_class(block)].size;
+}
+auto thread_cache_pmr::n_shared_cached(size_type block) const -> size_type {
+    auto& list{state_->lists[slab_mmr::size_class(block)]};
+    std::scoped_lock lock{list.mutex};
+    return list.size;
+}
+// Thread binding
+auto thread_cache_pmr::bind_thread() -> thread_magazines& {
+    static thread_local thread_bindings<shared_state, thread_magazines> bindings;
+
+    auto& entries{bindings.entries};
+    std::erase_if(entries, [](auto const& e) { return e.state.expired(); });
+
+    // The thread may already have magazines here if it has used another instance since
+    for (auto const& e : entries) {
+        if (e.id == state_->id) {
+            thread_cache_ = {e.id, e.magazines};
+            return *e.magazines;
+        }
+    }
+
+    auto& magazines{state_->add_thread()};
+    entries.push_back({state_->id, &magazines, state_});
+
+    thread_cache_ = {state_->id, &magazines};
+    return magazines;
+}
+}
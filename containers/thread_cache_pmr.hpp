@@ -0,0 +1,188 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <vector>
+
+#include "misc.hpp"
+#include "new_delete_pmr.hpp"
+#include "pmr.hpp"
+#include "resource_mixins.hpp"
+#include "slab_mmr.hpp"
+
+namespace ml {
+struct thread_cache_options {
+    // Most blocks of one size class a thread keeps before handing some back
+    std::size_t magazine_capacity{64};
+    // Blocks moved between a thread and the shared lists at a time
+    std::size_t batch_size{32};
+    // Most free blocks of one size class kept in the shared lists, the rest go back upstream
+    std::size_t shared_capacity{1024};
+};
+
+/*
+Caching front-end over an upstream resource for small allocations made from many threads.
+
+Requests are rounded up to power-of-two size classes. Each thread keeps a magazine of free blocks per size class
+so most allocations and frees take no lock.
+Empty magazines are refilled in batches from shared per-class lists, which fall back to the upstream.
+Full magazines hand a batch back to the shared lists, which return their surplus to the upstream.
+
+Blocks of a size class are interchangeable so memory may be freed from any thread.
+A thread's magazines are flushed when it exits, the shared lists when the resource is destroyed.
+Requests larger than max_cached_size go straight to the upstream.
+*/
+class thread_cache_pmr : public pmr_mixins::dual_pmr<thread_cache_pmr> {
+    friend class pmr_mixins::dual_pmr<thread_cache_pmr>;
+  public:
+    using size_type = std::size_t;
+
+    static constexpr size_type max_cached_size{1024};
+    static constexpr size_type n_size_classes{
+        static_cast<size_type>(std::countr_zero(max_cached_size) - std::countr_zero(slab_mmr::min_block_size)) + 1};
+
+    thread_cache_pmr();
+    explicit thread_cache_pmr(ml::pmr* upstream, thread_cache_options const& options = {});
+    ~thread_cache_pmr() override = default;
+
+    thread_cache_pmr(thread_cache_pmr const&) = delete;
+    thread_cache_pmr(thread_cache_pmr&&) = delete;
+
+    auto operator=(thread_cache_pmr const&) -> thread_cache_pmr& = delete;
+    auto operator=(thread_cache_pmr&&) -> thread_cache_pmr& = delete;
+
+    // Access
+    auto upstream() const -> ml::pmr*;
+    auto options() const -> thread_cache_options const&;
+    // Free blocks of the size class held by the calling thread and by the shared lists
+    auto n_thread_cached(size_type block) -> size_type;
+    auto n_shared_cached(size_type block) const -> size_type;
+  protected:
+    auto do_allocate(std::size_t n_bytes, std::size_t alignment) -> void* override final;
+    void do_deallocate(void* p, std::size_t n_bytes, std::size_t alignment) override final;
+    // Grows in place if the new size falls in the same size class
+    auto do_extend(void* ptr, std::size_t old_bytes, std::size_t new_bytes, std::size_t alignment)
+        -> void* override final;
+  private:
+    struct free_block {
+        free_block* next;
+    };
+    struct magazine {
+        free_block* head{nullptr};
+        size_type size{0};
+    };
+    struct thread_magazines {
+        std::array<magazine, n_size_classes> classes{};
+    };
+    struct alignas(cache_line_size) shared_list {
+        std::mutex mutex;
+        free_block* head{nullptr};
+        size_type size{0};
+    };
+    struct shared_state {
+        shared_state(ml::pmr* upstream, thread_cache_options const& options);
+        ~shared_state();
+
+        // Moves up to n blocks into the magazine, allocating from the upstream if the shared list runs out
+        void refill(magazine& m, size_type size_class);
+        // Moves n blocks out of the magazine
+        void flush(magazine& m, size_type size_class, size_type n);
+        // Flushes and frees the magazines of an exiting thread
+        void flush_all(thread_magazines& magazines);
+        auto add_thread() -> thread_magazines&;
+        void release_to_upstream(free_block* head, size_type size_class);
+
+        ml::pmr* upstream{nullptr};
+        thread_cache_options options{};
+        std::array<shared_list, n_size_classes> lists{};
+        // Magazines of the threads using the resource, drained when it is destroyed
+        std::mutex threads_mutex;
+        std::vector<std::unique_ptr<thread_magazines>> threads;
+        // Identifies the instance in thread-local caches as addresses can be reused
+        size_type id{0};
+    };
+    struct thread_cache {
+        size_type id{0};
+        thread_magazines* magazines{nullptr};
+    };
+
+    auto local() -> thread_magazines&;
+    auto bind_thread() -> thread_magazines&;
+    static auto block_alignment(size_type block) -> size_type;
+
+    static thread_local thread_cache thread_cache_;
+    // Shared with the thread-exit hooks so they can tell if the instance still exists
+    std::shared_ptr<shared_state> state_;
+};
+
+inline thread_local thread_cache_pmr::thread_cache thread_cache_pmr::thread_cache_{};
+
+// Ctor
+inline thread_cache_pmr::thread_cache_pmr()
+    : thread_cache_pmr(get_new_delete_pmr<ml::pmr>()) {}
+// Access
+inline auto thread_cache_pmr::upstream() const -> ml::pmr* {
+    return state_->upstream;
+}
+inline auto thread_cache_pmr::options() const -> thread_cache_options const& {
+    return state_->options;
+}
+// Methods
+inline auto thread_cache_pmr::do_allocate(std::size_t n_bytes, std::size_t alignment) -> void* {
+    auto const block{slab_mmr::block_size(n_bytes, alignment)};
+    if (block > max_cached_size) {
+        return state_->upstream->allocate(n_bytes, alignment);
+    }
+
+    auto const size_class{slab_mmr::size_class(block)};
+    auto& m{local().classes[size_class]};
+    if (!m.head) {
+        state_->refill(m, size_class);
+    }
+    auto* node{m.head};
+    m.head = node->next;
+    --m.size;
+    return node;
+}
+inline void thread_cache_pmr::do_deallocate(void* p, std::size_t n_bytes, std::size_t alignment) {
+    auto const block{slab_mmr::block_size(n_bytes, alignment)};
+    if (block > max_cached_size) {
+        state_->upstream->deallocate(p, n_bytes, alignment);
+        return;
+    }
+
+    auto const size_class{slab_mmr::size_class(block)};
+    auto& m{local().classes[size_class]};
+    m.head = new (p) free_block{m.head};
+    ++m.size;
+    if (m.size > state_->options.magazine_capacity) {
+        state_->flush(m, size_class, state_->options.batch_size);
+    }
+}
+inline auto thread_cache_pmr::do_extend(void* ptr, std::size_t old_bytes, std::size_t new_bytes, std::size_t alignment)
+    -> void* {
+    if (!ptr) {
+        return do_allocate(new_bytes, alignment);
+    }
+    auto const old_block{slab_mmr::block_size(old_bytes, alignment)};
+    if (old_block <= max_cached_size && slab_mmr::block_size(new_bytes, alignment) == old_block) {
+        return ptr;
+    }
+    return do_allocate(new_bytes, alignment);
+}
+// Thread binding
+inline auto thread_cache_pmr::local() -> thread_magazines& {
+    if (thread_cache_.id == state_->id) {
+        return *thread_cache_.magazines;
+    }
+    return bind_thread();
+}
+inline auto thread_cache_pmr::block_alignment(size_type block) -> size_type {
+    // Any request which maps to the block has an alignment no larger than it
+    return block;
+}
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+namespace ml {
+// Storage for up to N objects which are constructed and destroyed by the owning container
+// Copies are bitwise when T is trivially copyable and unavailable otherwise
+template <typename T, std::size_t N>
+class uninitialized_array {
+  public:
+    auto data() noexcept -> T* { return reinterpret_cast<T*>(elems_.data()); }
+    auto data() const noexcept -> T const* { return reinterpret_cast<T const*>(elems_.data()); }
+    static constexpr auto capacity() noexcept -> std::size_t { return N; }
+  private:
+    union elem_t {
+        T value;
+
+        elem_t() {}
+        ~elem_t() {}
+    };
+
+    std::array<elem_t, N> elems_;
+};
+}
@@ -1,27 +1,72 @@
 #pragma once
 
+#include <algorithm>
 #include <concepts>
 #include <cstddef>
 #include <cstdint>
+#include <initializer_list>
+#include <iterator>
 #include <memory>
+#include <ranges>
 #include <type_traits>
 
+#include "allocator_concepts.hpp"
 #include "contiguous_container_mixins.hpp"
+#include "dynamic_array_mixins.hpp"
 #include "iterator_boilerplate.hpp"
+#include "relocation.hpp"
 #include "span_iterator.hpp"
 
 #include "preprocessor/platform_def.hpp"
 
 namespace ml {
-template <typename T, typename Allocator = std::allocator<T>>
+/*
+How a vector picks its new capacity when it runs out of room.
+
+Capacity is multiplied by numerator / denominator, e.g. 2/1 or 3/2.
+Once a block reaches page_threshold bytes, its size is rounded up to whole pages
+since large blocks come from the OS in pages and the remainder would go unused.
+A page_threshold of 0 disables the rounding.
+*/
+struct vector_growth_policy {
+    std::size_t numerator{2};
+    std::size_t denominator{1};
+    std::size_t page_threshold{0};
+    std::size_t page_size{4096};
+
+    constexpr auto next_capacity(std::size_t capacity, std::size_t min_capacity, std::size_t element_size) const
+        -> std::size_t {
+        auto n{std::max({capacity * numerator / denominator, capacity + 1, min_capacity})};
+        if (page_threshold && n * element_size >= page_threshold) {
+            auto const n_bytes{((n * element_size + page_size - 1) / page_size) * page_size};
+            n = n_bytes / element_size;
+        }
+        return n;
+    }
+};
+
+inline constexpr vector_growth_policy vector_growth_2x{};
+inline constexpr vector_growth_policy vector_growth_1_5x{.numerator = 3, .denominator = 2};
+inline constexpr vector_growth_policy vector_growth_1_5x_paged{
+    .numerator = 3, .denominator = 2, .page_threshold = 64 * 1024};
+
+/*
+Dynamic array.
+
+Allocators with allocate_at_least report the slack in each block, which is used as extra capacity.
+*/
+template <typename T, typename Allocator = std::allocator<T>, vector_growth_policy Growth = vector_growth_2x>
 class vector
     : public ContiguousIteratorMethods
     , public ContiguousContainerCommonMethods
-    , public ContiguousContainerCommonCapacityMethods {
+    , public ContiguousContainerCommonCapacityMethods
+    , public DynamicArrayModifierMethods {
     friend struct ContiguousContainerCommonMethods;
     friend struct ContiguousContainerCommonCapacityMethods;
+    friend struct DynamicArrayModifierMethods;
   public:
     using value_type = T;
+    using allocator_type = Allocator;
     using size_type = std::size_t;
     using difference_type = std::ptrdiff_t;
     using reference = T&;
@@ -33,18 +78,28 @@ class vector
     using reverse_iterator = std::reverse_iterator<iterator>;
     using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
+    static constexpr vector_growth_policy growth_policy{Growth};
+
     // Ctor
     vector() noexcept
         : alloc{} {}
     vector(Allocator const& alloc)
         : alloc{alloc} {}
+    template <std::input_iterator It, std::sentinel_for<It> Sentinel>
+    vector(It first, Sentinel last, Allocator const& alloc = Allocator())
+        : alloc{alloc} {
+        append_range(std::ranges::subrange(std::move(first), std::move(last)));
+    }
+    vector(std::initializer_list<T> values, Allocator const& alloc = Allocator())
+        : alloc{alloc} {
+        append_range(values);
+    }
     // Copy ctor
     vector(vector const& other, Allocator const& alloc)
         : alloc{alloc} {
         reserve(other.capacity_);
-        for (auto const& item : other) {
-            push_back(item);
-        }
+        copy_construct(other.data(), other.size_, data());
+        size_ = other.size_;
     }
     vector(vector const& other)
         : vector(other, other.alloc) {}
@@ -61,15 +116,30 @@ class vector
 
     // Copy assignment
     auto& operator=(vector const& other) {
-        clear();
-        for (auto const& item : other) {
-            push_back(item);
+        if (this != &other) {
+            copy_elements_from(other);
         }
+        return *this;
     }
     // Move assignment
     auto& operator=(vector&& other) {
+        if (this == &other) {
+            return *this;
+        }
+
+        constexpr bool propagate{std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value};
+        if constexpr (!propagate) {
+            if (!(alloc == other.alloc)) {
+                move_elements_from(other);
+                return *this;
+            }
+        }
+
         clear();
-        alloc = std::move(other.alloc);
+        release();
+        if constexpr (propagate) {
+            alloc = std::move(other.alloc);
+        }
         data_ = other.data_;
         size_ = other.size_;
         capacity_ = other.capacity_;
@@ -77,11 +147,12 @@ class vector
         other.data_ = nullptr;
         other.size_ = 0;
         other.capacity_ = 0;
+        return *this;
     }
 
     ~vector() {
         for (auto i{0uz}; i < size_; ++i) {
-            data_[i].~T();
+            data()[i].~T();
         }
         alloc.deallocate(data_, capacity_);
         data_ = nullptr;
@@ -99,56 +170,79 @@ class vector
             return;
         }
 
-        auto* new_data{self.alloc.allocate(new_capacity)};
+        auto [new_data, count]{self.allocate_at_least(new_capacity)};
+        relocate(self.data(), self.size_, std::to_address(new_data));
+
+        self.alloc.deallocate(self.data_, self.capacity_);
+        self.data_ = new_data;
+        self.capacity_ = count;
+    }
 
-        for (auto i{0uz}; i < self.size_; i++) {
-            new (new_data + i) T{std::move(self.data_[i])};
+    // Releases unused capacity, in place if the allocator can shrink the block
+    void shrink_to_fit(this vector& self) {
+        if (self.size_ == self.capacity_) {
+            return;
+        }
+        if constexpr (extendable_allocator<Allocator>) {
+            if (self.size_) {
+                auto* new_data{self.alloc.extend(self.data(), self.capacity_, self.size_)};
+                if (new_data != self.data()) {
+                    relocate(self.data(), self.size_, new_data);
+                    self.alloc.deallocate(self.data_, self.capacity_);
+                    self.data_ = new_data;
+                }
+                self.capacity_ = self.size_;
+                return;
+            }
         }
+        self.compact();
+    }
+    // Moves the elements into a new allocation which fits them exactly
+    void compact(this vector& self) {
+        auto new_data{self.size_ ? self.alloc.allocate(self.size_) : alloc_pointer{}};
+        relocate(self.data(), self.size_, std::to_address(new_data));
 
         self.alloc.deallocate(self.data_, self.capacity_);
         self.data_ = new_data;
-        self.capacity_ = new_capacity;
+        self.capacity_ = self.size_;
     }
 
-    void shrink_to_fit() { return; }
-
     // Modifiers
     void clear(this vector& self) {
         for (auto i{0uz}; i < self.size_; ++i) {
-            self.data_[i].~T();
+            self.data()[i].~T();
         }
         self.size_ = 0;
     }
+  private:
+    // The allocator's pointer type, e.g. offset_ptr for containers stored in a mapped file
+    using alloc_pointer = typename std::allocator_traits<Allocator>::pointer;
 
-    template <typename... Args>
-    void emplace_back(this vector& self, Args&&... args) {
-        auto const new_size{self.size_ + 1};
+    alloc_pointer data_{nullptr};
+    std::size_t size_{0};
+    std::size_t capacity_{0};
+    NO_UNIQUE_ADDRESS Allocator alloc;
 
-        if (new_size >= self.capacity_) {
-            self.grow();
+    // Grows by the policy, or straight to min_capacity if that is larger
+    void grow_to(this vector& self, size_type min_capacity) {
+        if (min_capacity > self.capacity_) {
+            self.reserve(Growth.next_capacity(self.capacity_, min_capacity, sizeof(T)));
         }
-
-        new (self.data_ + self.size_) T{std::forward<Args>(args)...};
-        ++self.size_;
     }
-
-    template <typename U>
-        requires std::constructible_from<T, U>
-    void push_back(this vector& self, U&& value) {
-        auto const new_size{self.size_ + 1};
-        if (new_size >= self.capacity_) {
-            self.grow();
+    auto allocate_at_least(this vector& self, size_type n) -> allocation_result<alloc_pointer> {
+        if constexpr (at_least_allocator<Allocator>) {
+            auto [ptr, count]{self.alloc.allocate_at_least(n)};
+            return {ptr, static_cast<size_type>(count)};
+        } else {
+            return {self.alloc.allocate(n), n};
         }
-        new (self.data_ + self.size_) T{std::forward<U>(value)};
-        ++self.size_;
     }
-  private:
-    T* data_{nullptr};
-    std::size_t size_{0};
-    std::size_t capacity_{0};
-    NO_UNIQUE_ADDRESS Allocator alloc;
-
-    void grow(this vector& self) { self.reserve(self.capacity_ ? self.capacity_ * 2uz : 1uz); }
+    // Frees the block without touching the elements
+    void release(this vector& self) {
+        self.alloc.deallocate(self.data_, self.capacity_);
+        self.data_ = nullptr;
+        self.capacity_ = 0;
+    }
 };
 
 }
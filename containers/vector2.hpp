@@ -1,16 +1,20 @@
 #pragma once
 
+#include <algorithm>
 #include <cstddef>
 #include <iterator>
 #include <limits>
+#include <memory>
 #include <stdexcept>
 #include <type_traits>
 #include <utility>
 
 #include "allocator_concepts.hpp"
 #include "contiguous_container_mixins.hpp"
+#include "dynamic_array_mixins.hpp"
 #include "iterator_boilerplate.hpp"
 #include "pmr.hpp"
+#include "relocation.hpp"
 #include "span_iterator.hpp"
 
 #include "preprocessor/noexcept_release_def.hpp"
@@ -22,8 +26,10 @@ template <typename T, typename Allocator>
     requires (extendable_allocator<Allocator> && can_allocate_bytes<Allocator>)
 class vector2
     : public ContiguousIteratorMethods
-    , public ContiguousContainerCommonCapacityMethods {
+    , public ContiguousContainerCommonCapacityMethods
+    , public DynamicArrayModifierMethods {
     friend struct ContiguousContainerCommonCapacityMethods;
+    friend struct DynamicArrayModifierMethods;
   public:
     using value_type = T;
     using allocator_type = Allocator;
@@ -45,11 +51,48 @@ class vector2
     vector2() noexcept = default;
     vector2(ml::pmr* resource)
         : allocator_{resource} {}
+    vector2(allocator_type const& allocator)
+        : allocator_{allocator} {}
+    vector2(vector2 const& other)
+        : allocator_{other.allocator_} {
+        if (other.size_) {
+            data_ = allocator_.allocate(other.size_);
+            copy_construct(other.data_, other.size_, data_);
+            size_ = other.size_;
+            capacity_ = other.size_;
+        }
+    }
+    vector2(vector2&& other) noexcept
+        : allocator_{other.allocator_}
+        , size_{std::exchange(other.size_, 0)}
+        , capacity_{std::exchange(other.capacity_, 0)}
+        , data_{std::exchange(other.data_, nullptr)} {}
     ~vector2() {
         destroy_all_elements();
         allocator_.deallocate(data_, capacity_);
     }
 
+    auto operator=(vector2 const& other) -> vector2& {
+        if (this != &other) {
+            vector2 copy{other};
+            swap(copy);
+        }
+        return *this;
+    }
+    auto operator=(vector2&& other) noexcept -> vector2& {
+        if (this != &other) {
+            vector2 moved{std::move(other)};
+            swap(moved);
+        }
+        return *this;
+    }
+    void swap(vector2& other) noexcept {
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(allocator_, other.allocator_);
+    }
+
     // Element access
     template <typename Self>
     auto at(this Self&& self, size_type index) -> auto& {
@@ -83,18 +126,38 @@ class vector2
         return std::numeric_limits<difference_type>::max() / sizeof(int);
     }
     auto full() const noexcept -> bool { return size_ == capacity_; }
+    // Extends the current block in place if the allocator can
+    void reserve(size_type new_capacity) {
+        if (new_capacity > capacity_) {
+            change_capacity(new_capacity);
+        }
+    }
+    // Returns the unused tail to the allocator, in place if it can shrink the block
+    void shrink_to_fit() {
+        if (size_ == capacity_) {
+            return;
+        }
+        if (!size_) {
+            release();
+            return;
+        }
+        change_capacity(size_);
+    }
+    // Moves the elements into a new allocation which fits them exactly
+    void compact() {
+        auto* new_data{size_ ? allocator_.allocate(size_) : nullptr};
+        relocate(data_, size_, new_data);
+
+        allocator_.deallocate(data_, capacity_);
+        data_ = new_data;
+        capacity_ = size_;
+    }
 
     // Modifiers
     void clear() {
         destroy_all_elements();
         size_ = 0;
     }
-    template <typename... Args>
-    void emplace_back(Args&&... args) {
-        grow_if_full();
-        new (data_ + size_) value_type{std::forward<Args>(args)...};
-        ++size_;
-    }
     void pop_back() {
         index_check_DEBUG(0);
 
@@ -103,12 +166,6 @@ class vector2
             data_[size_].~value_type();
         }
     }
-    template <typename U>
-    void push_back(U&& new_elem) {
-        grow_if_full();
-        new (data_ + size_) value_type{std::forward<U>(new_elem)};
-        ++size_;
-    }
   private:
     // Element access
 #ifdef DEBUG_ENABLED
@@ -123,31 +180,39 @@ class vector2
         }
     }
     // Capacity
-    void grow() {
-        auto const old_size{size_};
-        auto const new_size{size_ ? size_ * 2 : 1};
+    // Resizes the block, extending or shrinking it in place if the allocator can
+    void change_capacity(size_type new_capacity) {
+        // Trivially relocatable elements can be moved by the allocator, e.g. with realloc or mremap
+        if constexpr (is_trivially_relocatable_v<T> && reallocatable_allocator<Allocator>) {
+            data_ = allocator_.reallocate(data_, capacity_, new_capacity);
+            capacity_ = new_capacity;
+            return;
+        }
 
         auto* current_data{data_};
-        auto* new_data{allocator_.extend(current_data, old_size, new_size)};
-        capacity_ = new_size;
-
-        data_ = new_data;
+        auto* new_data{allocator_.extend(current_data, capacity_, new_capacity)};
 
         if (new_data != current_data) {
-            // Move the objects to the new buffer
-            for (std::size_t i{0}; i < old_size; ++i) {
-                new (new_data + i) T{std::move(current_data[i])};
-            }
+            relocate(current_data, size_, new_data);
 
             // Deallocate the old buffer
-            allocator_.deallocate(current_data, old_size);
+            allocator_.deallocate(current_data, capacity_);
         }
+        data_ = new_data;
+        capacity_ = new_capacity;
     }
-    void grow_if_full() {
-        if (full()) {
-            grow();
+    // Doubles the capacity, or grows straight to min_capacity if that is larger
+    void grow_to(size_type min_capacity) {
+        if (min_capacity > capacity_) {
+            change_capacity(std::max(min_capacity, capacity_ * 2));
         }
     }
+    // Frees the block without touching the elements
+    void release() {
+        allocator_.deallocate(data_, capacity_);
+        data_ = nullptr;
+        capacity_ = 0;
+    }
     // Modifiers
     void destroy_all_elements() {
         if constexpr (elems_must_be_destroyed) {
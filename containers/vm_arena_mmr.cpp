@@ -0,0 +1,186 @@
+#include <cstdint>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "vm_arena_mmr.hpp"
+
+namespace ml {
+namespace {
+constexpr std::size_t huge_page_size{std::size_t{2} << 20};
+
+auto round_up(std::size_t n, std::size_t multiple) -> std::size_t {
+    return ((n + multiple - 1) / multiple) * multiple;
+}
+auto system_page_size() -> std::size_t {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwPageSize;
+#else
+    return static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#endif
+}
+// Huge pages must be committed whole
+auto commit_unit(vm_arena_options const& options) -> std::size_t {
+    auto const page{options.page_mode == vm_page_mode::normal ? system_page_size() : huge_page_size};
+    return round_up(options.commit_granularity ? options.commit_granularity : page, page);
+}
+}
+
+vm_arena_mmr::vm_arena_mmr()
+    : vm_arena_mmr(vm_arena_options{}) {}
+vm_arena_mmr::vm_arena_mmr(vm_arena_options const& options)
+    : options_{options} {
+    options_.commit_granularity = commit_unit(options_);
+    auto const n_bytes{round_up(options_.reserve_bytes, options_.commit_granularity)};
+
+#ifdef _WIN32
+    auto* ptr{VirtualAlloc(nullptr, n_bytes, MEM_RESERVE, PAGE_NOACCESS)};
+    if (!ptr) {
+        throw std::bad_alloc{};
+    }
+#else
+    int flags{MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE};
+#ifdef MAP_HUGETLB
+    if (options_.page_mode == vm_page_mode::huge_tlb) {
+        flags |= MAP_HUGETLB;
+    }
+#endif
+    // mmap only aligns to the normal page size, so transparent huge pages over-reserve by a huge page
+    // and trim the range to a huge page boundary, otherwise no madvised range would cover a whole one
+    auto const thp{options_.page_mode == vm_page_mode::transparent_huge};
+    auto const n_mapped{thp ? n_bytes + huge_page_size : n_bytes};
+    auto* ptr{mmap(nullptr, n_mapped, PROT_NONE, flags, -1, 0)};
+    if (ptr == MAP_FAILED) {
+        throw std::bad_alloc{};
+    }
+    if (thp) {
+        auto* const mapped{static_cast<std::byte*>(ptr)};
+        auto const address{reinterpret_cast<std::uintptr_t>(mapped)};
+        auto* const aligned{mapped + (round_up(address, huge_page_size) - address)};
+        if (auto const head{static_cast<std::size_t>(aligned - mapped)}) {
+            munmap(mapped, head);
+        }
+        if (auto const tail{static_cast<std::size_t>(mapped + n_mapped - (aligned + n_bytes))}) {
+            munmap(aligned + n_bytes, tail);
+        }
+        ptr = aligned;
+    }
+#endif
+
+    base_ = static_cast<std::byte*>(ptr);
+    reserved_ = n_bytes;
+}
+vm_arena_mmr::~vm_arena_mmr() {
+    release();
+}
+vm_arena_mmr::vm_arena_mmr(vm_arena_mmr&& other) noexcept
+    : base_{std::exchange(other.base_, nullptr)}
+    , size_{std::exchange(other.size_, 0)}
+    , committed_{std::exchange(other.committed_, 0)}
+    , reserved_{std::exchange(other.reserved_, 0)}
+    , options_{other.options_} {}
+auto vm_arena_mmr::operator=(vm_arena_mmr&& other) noexcept -> vm_arena_mmr& {
+    if (this != &other) {
+        release();
+        base_ = std::exchange(other.base_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+        committed_ = std::exchange(other.committed_, 0);
+        reserved_ = std::exchange(other.reserved_, 0);
+        options_ = other.options_;
+    }
+    return *this;
+}
+
+void vm_arena_mmr::reset() {
+    if (committed_) {
+#ifdef _WIN32
+        VirtualFree(base_, committed_, MEM_DECOMMIT);
+        committed_ = 0;
+#else
+        // The range stays readable and writable, the next touch gets a zeroed page
+        madvise(base_, committed_, MADV_DONTNEED);
+#endif
+    }
+    size_ = 0;
+}
+
+void vm_arena_mmr::commit_to(size_type new_size) {
+    if (new_size > reserved_) {
+        throw std::bad_alloc{};
+    }
+
+    auto const new_committed{round_up(new_size, options_.commit_granularity)};
+    auto* const start{base_ + committed_};
+    auto const n_bytes{new_committed - committed_};
+
+#ifdef _WIN32
+    if (!VirtualAlloc(start, n_bytes, MEM_COMMIT, PAGE_READWRITE)) {
+        throw std::bad_alloc{};
+    }
+    if (options_.populate) {
+        auto const page{system_page_size()};
+        for (size_type i{0}; i < n_bytes; i += page) {
+            start[i] = std::byte{0};
+        }
+    }
+#else
+    auto const thp{options_.page_mode == vm_page_mode::transparent_huge};
+
+    // Replace the PROT_NONE placeholder with a usable mapping
+    int flags{MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED};
+#ifdef MAP_HUGETLB
+    if (options_.page_mode == vm_page_mode::huge_tlb) {
+        flags |= MAP_HUGETLB;
+    }
+#endif
+#ifdef MAP_POPULATE
+    // Transparent huge pages are populated after the madvise so they fault in as huge pages
+    if (options_.populate && !thp) {
+        flags |= MAP_POPULATE;
+    }
+#endif
+    if (mmap(start, n_bytes, PROT_READ | PROT_WRITE, flags, -1, 0) == MAP_FAILED) {
+        throw std::bad_alloc{};
+    }
+
+#ifdef MADV_HUGEPAGE
+    if (thp) {
+        madvise(start, n_bytes, MADV_HUGEPAGE);
+        if (options_.populate) {
+            auto const page{system_page_size()};
+            for (size_type i{0}; i < n_bytes; i += page) {
+                start[i] = std::byte{0};
+            }
+        }
+    }
+#endif
+#endif
+
+    committed_ = new_committed;
+}
+
+void vm_arena_mmr::release() {
+    if (!base_) {
+        return;
+    }
+#ifdef _WIN32
+    VirtualFree(base_, 0, MEM_RELEASE);
+#else
+    munmap(base_, reserved_);
+#endif
+    base_ = nullptr;
+    size_ = 0;
+    committed_ = 0;
+    reserved_ = 0;
+}
+}
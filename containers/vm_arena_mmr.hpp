@@ -0,0 +1,145 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+namespace ml {
+enum class vm_page_mode {
+    normal,
+    // Transparent huge pages via MADV_HUGEPAGE
+    transparent_huge,
+    // Explicit huge pages via MAP_HUGETLB, these need a reserved hugetlbfs pool
+    huge_tlb
+};
+
+struct vm_arena_options {
+    // Size of the address range reserved up front, nothing is committed until used
+    std::size_t reserve_bytes{std::size_t{1} << 30};
+    // Pages are committed in multiples of this as the bump pointer moves
+    std::size_t commit_granularity{std::size_t{1} << 16};
+    vm_page_mode page_mode{vm_page_mode::normal};
+    // Pre-fault committed pages (MAP_POPULATE) so first touch doesn't page fault
+    bool populate{false};
+};
+
+/*
+Arena which reserves one contiguous virtual address range and commits pages as it grows.
+
+All allocations come from a single range so the most recent allocation can always be
+extended in place until the reservation runs out.
+reset() hands the physical pages back to the OS (MADV_DONTNEED) but keeps the reservation.
+Only POSIX (mmap) and Windows (VirtualAlloc) are supported.
+*/
+class vm_arena_mmr {
+  public:
+    using size_type = std::size_t;
+
+    vm_arena_mmr();
+    explicit vm_arena_mmr(vm_arena_options const& options);
+    ~vm_arena_mmr();
+
+    vm_arena_mmr(vm_arena_mmr const&) = delete;
+    vm_arena_mmr(vm_arena_mmr&& other) noexcept;
+
+    auto operator=(vm_arena_mmr const&) -> vm_arena_mmr& = delete;
+    auto operator=(vm_arena_mmr&& other) noexcept -> vm_arena_mmr&;
+
+    // Access
+    auto data() const -> std::byte*;
+    auto options() const -> vm_arena_options const&;
+
+    // Capacity
+    auto size() const -> size_type;
+    auto committed() const -> size_type;
+    auto reserved() const -> size_type;
+
+    // Allocation
+    [[nodiscard]] auto allocate(size_type n_bytes, size_type alignment) -> void*;
+    auto deallocate(void* ptr, size_type n_bytes, size_type alignment) -> void;
+    // Grows in place if ptr is the most recent allocation and the reservation has room
+    [[nodiscard]] auto extend(void* ptr, size_type old_bytes, size_type new_bytes, size_type alignment)
+        -> void*;
+
+    // Rewinding
+    void reset();
+    auto mark() const -> size_type;
+    void rewind(size_type m);
+  private:
+    // Commits pages so that at least new_size bytes are usable
+    void commit_to(size_type new_size);
+    void release();
+
+    std::byte* base_{nullptr};
+    size_type size_{0};
+    size_type committed_{0};
+    size_type reserved_{0};
+    vm_arena_options options_{};
+};
+
+// Access
+inline auto vm_arena_mmr::data() const -> std::byte* {
+    return base_;
+}
+inline auto vm_arena_mmr::options() const -> vm_arena_options const& {
+    return options_;
+}
+// Capacity
+inline auto vm_arena_mmr::size() const -> size_type {
+    return size_;
+}
+inline auto vm_arena_mmr::committed() const -> size_type {
+    return committed_;
+}
+inline auto vm_arena_mmr::reserved() const -> size_type {
+    return reserved_;
+}
+// Allocation
+inline auto vm_arena_mmr::allocate(size_type n_bytes, size_type alignment) -> void* {
+    auto const start{reinterpret_cast<std::uintptr_t>(base_) + size_};
+    auto const padding{(alignment - (start % alignment)) % alignment};
+    auto const new_size{size_ + padding + n_bytes};
+
+    if (new_size > committed_) {
+        commit_to(new_size);
+    }
+
+    auto* ptr{base_ + size_ + padding};
+    size_ = new_size;
+    return ptr;
+}
+inline auto vm_arena_mmr::deallocate(void* /*ptr*/, size_type /*n_bytes*/, size_type /*alignment*/) -> void {
+    // no-op
+    return;
+}
+inline auto vm_arena_mmr::extend(void* ptr, size_type old_bytes, size_type new_bytes, size_type alignment)
+    -> void* {
+    if (!ptr) {
+        return allocate(new_bytes, alignment);
+    }
+    if (new_bytes <= old_bytes) {
+        return ptr;
+    }
+
+    auto* const expected_start{base_ + size_ - old_bytes};
+    if ((old_bytes > size_) || (expected_start != ptr)) {
+        return allocate(new_bytes, alignment);
+    }
+
+    auto const new_size{size_ + (new_bytes - old_bytes)};
+    if (new_size > committed_) {
+        commit_to(new_size);
+    }
+    size_ = new_size;
+    return ptr;
+}
+// Rewinding
+inline auto vm_arena_mmr::mark() const -> size_type {
+    return size_;
+}
+inline void vm_arena_mmr::rewind(size_type m) {
+    if (m < size_) {
+        size_ = m;
+    }
+}
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <unordered_map>
+
+#include <gtest/gtest.h>
+
+// Checks every block is deallocated with the size it was allocated with
+class size_checking_resource : public std::pmr::memory_resource {
+  public:
+    ~size_checking_resource() override { EXPECT_TRUE(sizes_.empty()); }
+
+    // Access
+    auto n_live_blocks() const -> std::size_t { return sizes_.size(); }
+  protected:
+    auto do_allocate(std::size_t n_bytes, std::size_t alignment) -> void* override {
+        auto* ptr{std::pmr::new_delete_resource()->allocate(n_bytes, alignment)};
+        sizes_[ptr] = n_bytes;
+        return ptr;
+    }
+    void do_deallocate(void* ptr, std::size_t n_bytes, std::size_t alignment) override {
+        auto it{sizes_.find(ptr)};
+        ASSERT_NE(it, sizes_.end());
+        EXPECT_EQ(it->second, n_bytes);
+        sizes_.erase(it);
+        std::pmr::new_delete_resource()->deallocate(ptr, n_bytes, alignment);
+    }
+    auto do_is_equal(std::pmr::memory_resource const& other) const noexcept -> bool override {
+        return this == &other;
+    }
+  private:
+    std::unordered_map<void*, std::size_t> sizes_;
+};
@@ -142,6 +142,311 @@ TEST(arena, extend) {
 
     EXPECT_EQ(ptr1, ptr2);
 }
+TEST(arena, extend_shrinks_last_allocation) {
+    ml::arena_mmr resource{256};
+
+    auto* ptr1{resource.allocate(32, 1)};
+    auto* ptr2{resource.allocate(64, 1)};
+    EXPECT_EQ(resource.extend(ptr2, 64, 16, 1), ptr2);
+    EXPECT_EQ(resource.total_size(), 48);
+
+    // Only the most recent allocation gives memory back
+    EXPECT_EQ(resource.extend(ptr1, 32, 8, 1), ptr1);
+    EXPECT_EQ(resource.total_size(), 48);
+}
+TEST(arena, extend_past_pool_capacity) {
+    ml::arena_mmr resource{64};
+
+    auto* ptr1{resource.allocate(32, 1)};
+    auto* ptr2{resource.extend(ptr1, 32, 128, 1)};
+
+    EXPECT_NE(ptr1, ptr2);
+    EXPECT_EQ(resource.n_pools(), 2);
+}
+
+// Rewinding
+TEST(arena, reset_keeps_pools) {
+    ml::arena_mmr resource;
+
+    (void)resource.allocate(resource.initial_capacity(), alignof(std::byte));
+    (void)resource.allocate(resource.initial_capacity() * 2, alignof(std::byte));
+    auto const* head{resource.pool()};
+    ASSERT_EQ(resource.n_pools(), 2);
+
+    resource.reset();
+    EXPECT_EQ(resource.total_size(), 0);
+    EXPECT_EQ(resource.n_pools(), 2);
+    EXPECT_EQ(resource.pool(), head);
+}
+TEST(arena, reset_steady_state_reuses_pools) {
+    ml::arena_mmr resource;
+    auto run_request{[&resource]() {
+        for (std::size_t i{1}; i < 200; ++i) {
+            (void)resource.allocate(i * 8, alignof(std::max_align_t));
+        }
+    }};
+
+    run_request();
+    auto const n_pools{resource.n_pools()};
+    auto const capacity{resource.total_capacity()};
+
+    for (int i{0}; i < 5; ++i) {
+        resource.reset();
+        run_request();
+        EXPECT_EQ(resource.n_pools(), n_pools);
+        EXPECT_EQ(resource.total_capacity(), capacity);
+    }
+}
+TEST(arena, reset_reuses_memory) {
+    ml::arena_mmr resource;
+
+    auto* ptr1{resource.allocate(64, alignof(std::max_align_t))};
+    resource.reset();
+    auto* ptr2{resource.allocate(64, alignof(std::max_align_t))};
+
+    EXPECT_EQ(ptr1, ptr2);
+}
+TEST(arena, reset_retention_limit) {
+    ml::arena_mmr resource{1024, 4096};
+
+    (void)resource.allocate(1024, alignof(std::byte));
+    (void)resource.allocate(4096, alignof(std::byte));
+    (void)resource.allocate(16384, alignof(std::byte));
+    ASSERT_EQ(resource.n_pools(), 3);
+
+    resource.reset();
+    EXPECT_EQ(resource.n_pools(), 1);
+    EXPECT_LE(resource.total_capacity(), 4096);
+}
+TEST(arena, reset_retain_nothing) {
+    ml::arena_mmr resource{1024, 0};
+
+    (void)resource.allocate(64, alignof(std::byte));
+    resource.reset();
+    EXPECT_EQ(resource.pool(), nullptr);
+
+    EXPECT_NE(resource.allocate(64, alignof(std::byte)), nullptr);
+}
+TEST(arena, rewind_within_pool) {
+    ml::arena_mmr resource;
+
+    (void)resource.allocate(64, alignof(std::byte));
+    auto const m{resource.mark()};
+    auto* ptr1{resource.allocate(128, alignof(std::byte))};
+    EXPECT_EQ(resource.total_size(), 192);
+
+    resource.rewind(m);
+    EXPECT_EQ(resource.total_size(), 64);
+    EXPECT_EQ(resource.allocate(128, alignof(std::byte)), ptr1);
+}
+TEST(arena, rewind_across_pools) {
+    ml::arena_mmr resource;
+
+    (void)resource.allocate(64, alignof(std::byte));
+    auto const m{resource.mark()};
+    (void)resource.allocate(resource.initial_capacity() * 4, alignof(std::byte));
+    (void)resource.allocate(resource.initial_capacity() * 16, alignof(std::byte));
+    auto const n_pools{resource.n_pools()};
+
+    resource.rewind(m);
+    EXPECT_EQ(resource.total_size(), 64);
+    EXPECT_EQ(resource.n_pools(), n_pools);
+
+    // The kept pools are used again
+    (void)resource.allocate(resource.initial_capacity() * 4, alignof(std::byte));
+    (void)resource.allocate(resource.initial_capacity() * 16, alignof(std::byte));
+    EXPECT_EQ(resource.n_pools(), n_pools);
+}
+TEST(arena, rewind_to_empty_mark) {
+    ml::arena_mmr resource;
+
+    auto const m{resource.mark()};
+    (void)resource.allocate(64, alignof(std::byte));
+    resource.rewind(m);
+    EXPECT_EQ(resource.total_size(), 0);
+}
+TEST(arena, oversized_request_skips_small_kept_pool) {
+    ml::arena_mmr resource;
+
+    (void)resource.allocate(16, alignof(std::byte));
+    (void)resource.allocate(resource.initial_capacity() * 2, alignof(std::byte));
+    resource.reset();
+
+    (void)resource.allocate(16, alignof(std::byte));
+    auto* ptr{resource.allocate(resource.initial_capacity() * 8, alignof(std::byte))};
+    EXPECT_NE(ptr, nullptr);
+    EXPECT_EQ(resource.n_pools(), 3);
+}
+
+// Growth policy
+TEST(arena, geometric_growth_doubles_pools) {
+    constexpr std::size_t initial{256};
+    ml::arena_mmr resource{initial, ml::arena_growth_policy{.curve = ml::arena_growth_curve::geometric}};
+
+    // Pools of 256, 512 and 1024 bytes hold 2, 4 and 8 allocations
+    for (int i = 0; i < 7; ++i) {
+        (void)resource.allocate(initial / 2, alignof(std::byte));
+    }
+    EXPECT_EQ(resource.n_pools(), 3);
+    EXPECT_EQ(resource.total_capacity(), initial * 7);
+}
+TEST(arena, capped_growth_stops_at_max_pool_size) {
+    constexpr std::size_t initial{256};
+    ml::arena_mmr resource{initial,
+                           ml::arena_growth_policy{.curve = ml::arena_growth_curve::geometric,
+                                                   .max_pool_size = initial * 2}};
+
+    // Pools of 256, 512, 512 and 512 bytes
+    for (int i = 0; i < 11; ++i) {
+        (void)resource.allocate(initial / 2, alignof(std::byte));
+    }
+    EXPECT_EQ(resource.n_pools(), 4);
+    EXPECT_EQ(resource.total_capacity(), initial * 7);
+
+    // A request above the cap still gets a pool large enough for it
+    auto* ptr{resource.allocate(initial * 8, alignof(std::byte))};
+    EXPECT_NE(ptr, nullptr);
+    EXPECT_GE(resource.total_capacity(), initial * 15);
+}
+TEST(arena, dedicated_pool_keeps_active_pool) {
+    constexpr std::size_t initial{1024};
+    ml::arena_mmr resource{initial, ml::arena_growth_policy{.dedicated_threshold = 512}};
+
+    auto* small1{static_cast<std::byte*>(resource.allocate(64, alignof(std::byte)))};
+    auto* large{resource.allocate(4096, alignof(std::byte))};
+    auto* small2{static_cast<std::byte*>(resource.allocate(64, alignof(std::byte)))};
+
+    EXPECT_NE(large, nullptr);
+    // The large allocation didn't move the small ones off the first pool
+    EXPECT_EQ(small2, small1 + 64);
+    EXPECT_EQ(resource.n_pools(), 2);
+    EXPECT_EQ(resource.total_size(), 64 + 4096 + 64);
+    EXPECT_EQ(resource.total_capacity(), initial + 4096 + alignof(std::byte));
+}
+TEST(arena, dedicated_pools_released_on_reset) {
+    ml::arena_mmr resource{1024, ml::arena_growth_policy{.dedicated_threshold = 512}};
+
+    (void)resource.allocate(64, alignof(std::byte));
+    (void)resource.allocate(2048, alignof(std::byte));
+    (void)resource.allocate(4096, alignof(std::byte));
+    EXPECT_EQ(resource.n_pools(), 3);
+
+    resource.reset();
+    EXPECT_EQ(resource.n_pools(), 1);
+    EXPECT_EQ(resource.total_capacity(), 1024);
+    EXPECT_EQ(resource.total_size(), 0);
+}
+TEST(arena, rewind_releases_newer_dedicated_pools) {
+    ml::arena_mmr resource{1024, ml::arena_growth_policy{.dedicated_threshold = 512}};
+
+    (void)resource.allocate(2048, alignof(std::byte));
+    auto const m{resource.mark()};
+    auto const size{resource.total_size()};
+    (void)resource.allocate(64, alignof(std::byte));
+    (void)resource.allocate(4096, alignof(std::byte));
+    (void)resource.allocate(8192, alignof(std::byte));
+    EXPECT_EQ(resource.n_pools(), 4);
+
+    resource.rewind(m);
+    EXPECT_EQ(resource.total_size(), size);
+    // The older dedicated pool and the kept small pool remain
+    EXPECT_EQ(resource.n_pools(), 2);
+}
+TEST(arena, move_keeps_dedicated_pools) {
+    ml::arena_mmr resource{1024, ml::arena_growth_policy{.dedicated_threshold = 512}};
+    (void)resource.allocate(2048, alignof(std::byte));
+
+    ml::arena_mmr moved{std::move(resource)};
+    EXPECT_EQ(moved.n_pools(), 1);
+    EXPECT_EQ(moved.total_size(), 2048);
+    EXPECT_EQ(moved.policy().dedicated_threshold, 512);
+    EXPECT_EQ(resource.n_pools(), 0);
+    EXPECT_EQ(resource.total_size(), 0);
+}
+
+// Pool preparation
+TEST(arena, prepared_pool_is_used_next) {
+    constexpr std::size_t initial{256};
+    ml::arena_mmr resource{initial, ml::arena_growth_policy{.curve = ml::arena_growth_curve::geometric}};
+
+    (void)resource.allocate(initial / 2, alignof(std::byte));
+    resource.prepare_next_pool();
+    EXPECT_TRUE(resource.next_pool_ready());
+    EXPECT_EQ(resource.n_pools(), 2);
+    EXPECT_EQ(resource.total_capacity(), initial * 3);
+
+    // Preparing again does nothing while a pool is waiting
+    resource.prepare_next_pool();
+    EXPECT_EQ(resource.n_pools(), 2);
+
+    // The prepared pool is moved to rather than a new one made
+    for (int i = 0; i < 4; ++i) {
+        (void)resource.allocate(initial / 2, alignof(std::byte));
+    }
+    EXPECT_EQ(resource.n_pools(), 2);
+    EXPECT_EQ(resource.total_size(), initial / 2 * 5);
+}
+TEST(arena, prepare_first_pool) {
+    constexpr std::size_t initial{256};
+    ml::arena_mmr resource{initial};
+
+    resource.prepare_next_pool();
+    EXPECT_EQ(resource.n_pools(), 1);
+    (void)resource.allocate(initial / 2, alignof(std::byte));
+    EXPECT_EQ(resource.n_pools(), 1);
+    EXPECT_EQ(resource.total_capacity(), initial);
+}
+TEST(arena, prepare_async) {
+    constexpr std::size_t initial{256};
+    ml::arena_mmr resource{initial};
+
+    (void)resource.allocate(initial / 2, alignof(std::byte));
+    resource.prepare_next_pool_async();
+    EXPECT_TRUE(resource.next_pool_ready());
+
+    for (int i = 0; i < 3; ++i) {
+        (void)resource.allocate(initial / 2, alignof(std::byte));
+    }
+    EXPECT_EQ(resource.n_pools(), 2);
+    EXPECT_EQ(resource.total_capacity(), initial * 2);
+}
+TEST(arena, high_water_mark_prepares_in_the_background) {
+    constexpr std::size_t initial{1024};
+    ml::arena_mmr resource{initial,
+                           ml::arena_growth_policy{.curve = ml::arena_growth_curve::geometric,
+                                                   .prepare_high_water = 0.5}};
+
+    (void)resource.allocate(initial / 4, alignof(std::byte));
+    EXPECT_FALSE(resource.next_pool_ready());
+    (void)resource.allocate(initial / 2, alignof(std::byte));
+    EXPECT_TRUE(resource.next_pool_ready());
+
+    std::byte* last{nullptr};
+    for (int i = 0; i < 8; ++i) {
+        last = static_cast<std::byte*>(resource.allocate(initial / 4, alignof(std::byte)));
+        *last = std::byte{1};
+    }
+    EXPECT_EQ(resource.n_pools(), 2);
+    EXPECT_EQ(resource.total_capacity(), initial * 3);
+    // The second pool is past its threshold too so a third is on the way
+    EXPECT_TRUE(resource.next_pool_ready());
+}
+TEST(arena, pending_pool_survives_move_and_reset) {
+    ml::arena_mmr resource{256};
+    (void)resource.allocate(64, alignof(std::byte));
+    resource.prepare_next_pool_async();
+
+    ml::arena_mmr moved{std::move(resource)};
+    EXPECT_TRUE(moved.next_pool_ready());
+    EXPECT_FALSE(resource.next_pool_ready());
+
+    moved.reset();
+    EXPECT_TRUE(moved.next_pool_ready());
+    ml::arena_mmr assigned{256};
+    assigned.prepare_next_pool_async();
+    assigned = std::move(moved);
+    EXPECT_TRUE(assigned.next_pool_ready());
+}
 
 // Vector usage
 TEST(arena, vector_basic_operations) {
@@ -267,6 +572,61 @@ TEST(arena_pmr, allocate_large_object) {
     EXPECT_NE(ptr, nullptr);
     resource.deallocate(ptr, large_size, alignof(std::byte));
 }
+TEST(arena_pmr, reset_and_rewind) {
+    ml::arena_pmr resource;
+
+    auto* ptr1{resource.allocate(32, alignof(std::max_align_t))};
+    auto const m{resource.mark()};
+    auto const size{resource.arena().total_size()};
+    (void)resource.allocate(32, alignof(std::max_align_t));
+    resource.rewind(m);
+    EXPECT_EQ(resource.arena().total_size(), size);
+
+    resource.reset();
+    EXPECT_EQ(resource.arena().total_size(), 0);
+    EXPECT_EQ(resource.allocate(32, alignof(std::max_align_t)), ptr1);
+}
+TEST(arena_pmr, prepare_next_pool) {
+    constexpr std::size_t initial{256};
+    ml::arena_pmr resource{initial};
+
+    (void)resource.allocate(initial / 2, alignof(std::byte));
+    EXPECT_FALSE(resource.next_pool_ready());
+    resource.prepare_next_pool();
+    EXPECT_TRUE(resource.next_pool_ready());
+    EXPECT_EQ(resource.arena().n_pools(), 2);
+
+    ml::arena_pmr async_resource{initial};
+    (void)async_resource.allocate(initial / 2, alignof(std::byte));
+    async_resource.prepare_next_pool_async();
+    EXPECT_TRUE(async_resource.next_pool_ready());
+    for (int i = 0; i < 3; ++i) {
+        (void)async_resource.allocate(initial / 2, alignof(std::byte));
+    }
+    EXPECT_EQ(async_resource.arena().n_pools(), 2);
+}
+TEST(arena_pmr, ml_pmr_extend) {
+    ml::arena_pmr resource;
+    ml::pmr& base{resource};
+
+    auto* ptr1{base.allocate(16, alignof(int))};
+    auto* ptr2{base.extend(ptr1, 16, 32, alignof(int))};
+    EXPECT_EQ(ptr1, ptr2);
+    EXPECT_TRUE(base.is_equal(resource));
+}
+TEST(arena_pmr, shared_between_interfaces) {
+    ml::arena_pmr resource;
+    std::pmr::vector<int> values{&resource};
+    values.push_back(1);
+
+    ml::pmr& base{resource};
+    auto* ptr1{base.allocate(16, alignof(int))};
+    // The extend fast path still applies after std::pmr allocations
+    EXPECT_EQ(base.extend(ptr1, 16, 64, alignof(int)), ptr1);
+
+    std::pmr::memory_resource& std_base{resource};
+    EXPECT_TRUE(std_base.is_equal(resource));
+}
 TEST(arena_pmr, pmr_vector_basic_operations) {
     ml::arena_pmr resource;
     std::pmr::polymorphic_allocator<int> alloc{&resource};
@@ -5,6 +5,9 @@
 #include <gtest/gtest.h>
 
 #include "containers/bst.hpp"
+#include "containers/pmr.hpp"
+#include "containers/pmr_allocator.hpp"
+#include "containers/slab_pmr.hpp"
 
 #include "configure_warning_pragmas.hpp"
 
@@ -230,3 +233,20 @@ TEST(bst, iterator_reverse_order) {
         EXPECT_EQ(*b_it, *v_it);
     }
 }
+TEST(bst, slab_allocator_reuses_nodes) {
+    using tree_type = ml::bst<int, std::less<>, ml::pmr_allocator>;
+
+    ml::slab_pmr<ml::pmr> resource;
+    tree_type bst{tree_type::allocator_type{&resource}};
+
+    for (int round{0}; round < 10; ++round) {
+        for (auto const& value : values2) {
+            bst.insert(value);
+        }
+        EXPECT_EQ(bst.size(), values2.size());
+        bst.clear();
+    }
+
+    EXPECT_TRUE(bst.empty());
+    EXPECT_EQ(resource.slab().n_chunks(), 1);
+}
@@ -4,11 +4,15 @@
 
 #include <gtest/gtest.h>
 
+#include "size_checking_resource.hpp"
+
 #include "containers/pmr.hpp"
 #include "containers/mmr_allocator.hpp"
 #include "containers/pmr_allocator.hpp"
 #include "containers/buffer_mmr.hpp"
 #include "containers/buffer_pmr.hpp"
+#include "containers/stats_pmr.hpp"
+#include "containers/vector.hpp"
 
 #include "configure_warning_pragmas.hpp"
 
@@ -88,6 +92,69 @@ TEST(buffer_mmr, vector_push_back_overflow) {
 
     FAIL() << "Should have thrown an exception";
 }
+TEST(buffer_mmr, overflow_to_upstream) {
+    ml::stats_pmr upstream{std::pmr::new_delete_resource()};
+    ml::buffer_mmr<64> resource{&upstream};
+
+    auto* ptr1{resource.allocate(32, 8)};
+    EXPECT_TRUE(resource.owns(ptr1));
+    EXPECT_EQ(upstream.stats().n_allocations, 0);
+
+    auto* ptr2{resource.allocate(64, 8)};
+    EXPECT_FALSE(resource.owns(ptr2));
+    EXPECT_EQ(upstream.stats().n_allocations, 1);
+
+    // Only upstream allocations are passed back
+    resource.deallocate(ptr1, 32, 8);
+    resource.deallocate(ptr2, 64, 8);
+    EXPECT_EQ(upstream.stats().n_deallocations, 1);
+    EXPECT_EQ(upstream.stats().live_bytes, 0);
+}
+TEST(buffer_mmr, vector_push_back_overflow_to_upstream) {
+    static constexpr std::size_t n_ints{5};
+    using config = VecConfig<int, n_ints>;
+    ml::stats_pmr upstream{std::pmr::new_delete_resource()};
+    config::Resource resource{&upstream};
+    config::Allocator alloc{&resource};
+
+    {
+        config::Vec vec{alloc};
+        for (int i{0}; i < 100; ++i) {
+            vec.push_back(i);
+        }
+        EXPECT_EQ(vec.back(), 99);
+        EXPECT_GT(upstream.stats().n_allocations, 0);
+    }
+    EXPECT_EQ(upstream.stats().live_bytes, 0);
+}
+TEST(buffer_mmr, shrink_of_upstream_block_allocates) {
+    size_checking_resource upstream;
+    ml::buffer_mmr<64> resource{&upstream};
+
+    auto* ptr1{resource.allocate(128, 8)};
+    EXPECT_FALSE(resource.owns(ptr1));
+    auto* ptr2{resource.extend(ptr1, 128, 96, 8)};
+    EXPECT_NE(ptr2, ptr1);
+    EXPECT_FALSE(resource.owns(ptr2));
+
+    resource.deallocate(ptr1, 128, 8);
+    resource.deallocate(ptr2, 96, 8);
+    EXPECT_EQ(upstream.n_live_blocks(), 0);
+}
+TEST(buffer_mmr, ml_vector_shrink_to_fit_on_upstream) {
+    size_checking_resource upstream;
+    ml::buffer_mmr<16> resource{&upstream};
+    {
+        ml::vector<int, ml::mmr_allocator<int, ml::buffer_mmr<16>>> values{&resource};
+        values.reserve(100);
+        values.push_back(1);
+        values.push_back(2);
+        values.shrink_to_fit();
+        EXPECT_EQ(values.capacity(), 2);
+        EXPECT_EQ(values[1], 2);
+    }
+    EXPECT_EQ(upstream.n_live_blocks(), 0);
+}
 
 // std::pmr
 TEST(buffer_pmr_std, init_pmr) {
@@ -160,3 +227,21 @@ TEST(buffer_pmr, extend_alloc_oob) {
 
     EXPECT_THROW(alloc.extend(ptr, 16, 320000000), std::bad_alloc);
 }
+TEST(buffer_pmr, extend_moves_to_upstream) {
+    ml::stats_pmr upstream{std::pmr::new_delete_resource()};
+    ml::buffer_pmr<int, 64, ml::pmr> resource{&upstream};
+    ml::pmr_allocator<int> alloc{&resource};
+
+    auto* ptr{alloc.allocate(16)};
+    EXPECT_EQ(alloc.extend(ptr, 16, 64), ptr);
+
+    auto* moved{alloc.extend(ptr, 64, 128)};
+    EXPECT_NE(moved, ptr);
+    EXPECT_EQ(upstream.stats().n_allocations, 1);
+
+    // Growing an upstream block keeps it upstream
+    auto* moved_again{alloc.extend(moved, 128, 256)};
+    alloc.deallocate(moved, 128);
+    alloc.deallocate(moved_again, 256);
+    EXPECT_EQ(upstream.stats().live_bytes, 0);
+}
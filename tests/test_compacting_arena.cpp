@@ -0,0 +1,234 @@
+#include <algorithm>
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "containers/binary_heap.hpp"
+#include "containers/compacting_arena_pmr.hpp"
+#include "containers/linked_vector.hpp"
+#include "containers/pmr_allocator.hpp"
+#include "containers/vector.hpp"
+#include "containers/vector2.hpp"
+
+#include "configure_warning_pragmas.hpp"
+
+template <typename T>
+using lvec = ml::linked_vector<T, ml::pmr_allocator<std::byte>>;
+template <typename T>
+using vec = ml::vector<T, ml::pmr_allocator<T>>;
+template <typename T>
+using vec2 = ml::vector2<T, ml::pmr_allocator<T>>;
+
+TEST(compacting_arena_pmr, compact_reclaims_dead_space) {
+    ml::compacting_arena_pmr resource{4096};
+    lvec<int> values{&resource};
+    resource.track(values);
+
+    for (int i{0}; i < 1000; ++i) {
+        values.push_back(i);
+        // Dead allocations interleaved with the live segments
+        resource.deallocate(resource.allocate(256), 256);
+    }
+    auto const capacity_before{resource.arena().total_capacity()};
+
+    auto const released{resource.compact()};
+    EXPECT_GT(released, 0);
+    EXPECT_EQ(resource.arena().total_capacity(), capacity_before - released);
+    EXPECT_LT(resource.arena().total_size(), 1000 * sizeof(int) + 256);
+
+    ASSERT_EQ(values.size(), 1000);
+    EXPECT_EQ(values.capacity(), 1000);
+    int expected{0};
+    for (auto const value : values) {
+        EXPECT_EQ(value, expected++);
+    }
+    resource.untrack(values);
+}
+TEST(compacting_arena_pmr, non_trivial_elements) {
+    ml::compacting_arena_pmr resource{1024};
+    lvec<std::string> strings{&resource};
+    resource.track(strings);
+
+    for (int i{0}; i < 100; ++i) {
+        strings.push_back(std::string(40, static_cast<char>('a' + i % 26)));
+    }
+    (void)resource.compact();
+
+    ASSERT_EQ(strings.size(), 100);
+    int i{0};
+    for (auto const& s : strings) {
+        EXPECT_EQ(s, std::string(40, static_cast<char>('a' + i % 26)));
+        ++i;
+    }
+    resource.untrack(strings);
+}
+TEST(compacting_arena_pmr, containers_keep_growing_after_compaction) {
+    ml::compacting_arena_pmr resource{1024};
+    lvec<int> a{&resource};
+    lvec<int> b{&resource};
+    resource.track(a);
+    resource.track(b);
+    EXPECT_EQ(resource.n_tracked(), 2);
+
+    for (int i{0}; i < 100; ++i) {
+        a.push_back(i);
+        b.push_back(-i);
+    }
+    (void)resource.compact();
+    for (int i{100}; i < 200; ++i) {
+        a.push_back(i);
+        b.push_back(-i);
+    }
+
+    int i{0};
+    for (auto const value : a) {
+        EXPECT_EQ(value, i++);
+    }
+    i = 0;
+    for (auto const value : b) {
+        EXPECT_EQ(value, -i++);
+    }
+    resource.untrack(a);
+    resource.untrack(b);
+    EXPECT_EQ(resource.n_tracked(), 0);
+}
+TEST(compacting_arena_pmr, empty_container) {
+    ml::compacting_arena_pmr resource{1024};
+    lvec<int> values{&resource};
+    values.reserve(100);
+    resource.track(values);
+
+    (void)resource.compact();
+    EXPECT_EQ(values.capacity(), 0);
+    EXPECT_EQ(resource.arena().total_size(), 0);
+
+    values.push_back(1);
+    EXPECT_EQ(values.size(), 1);
+    resource.untrack(values);
+}
+
+// Each container grows with dead allocations in between, compacts, then keeps its elements and can grow again
+namespace {
+struct throwing_compact {
+    bool should_throw{true};
+    void compact() {
+        if (should_throw) {
+            throw std::bad_alloc{};
+        }
+    }
+};
+}
+
+TEST(compacting_arena_pmr, throwing_compact_keeps_old_storage) {
+    ml::compacting_arena_pmr resource{1024};
+    vec<std::string> first{&resource};
+    throwing_compact thrower;
+    vec<std::string> second{&resource};
+    resource.track(first);
+    resource.track(thrower);
+    resource.track(second);
+
+    for (int i{0}; i < 50; ++i) {
+        first.push_back(std::string(40, 'a'));
+        second.push_back(std::string(40, 'b'));
+    }
+    EXPECT_THROW((void)resource.compact(), std::bad_alloc);
+
+    // first moved to the new arena, second was never reached and still uses the old one
+    EXPECT_EQ(first.size(), 50);
+    EXPECT_EQ(second.size(), 50);
+    EXPECT_TRUE(std::ranges::all_of(first, [](auto const& s) { return s == std::string(40, 'a'); }));
+    EXPECT_TRUE(std::ranges::all_of(second, [](auto const& s) { return s == std::string(40, 'b'); }));
+    second.push_back("c");
+
+    thrower.should_throw = false;
+    (void)resource.compact();
+    EXPECT_EQ(second.back(), "c");
+    EXPECT_EQ(first.front(), std::string(40, 'a'));
+
+    resource.untrack(first);
+    resource.untrack(thrower);
+    resource.untrack(second);
+}
+
+template <typename Container>
+void check_vector_compaction() {
+    ml::compacting_arena_pmr resource{1024};
+    Container values{static_cast<ml::pmr*>(&resource)};
+    resource.track(values);
+
+    for (int i{0}; i < 500; ++i) {
+        values.push_back(std::to_string(i));
+        resource.deallocate(resource.allocate(64), 64);
+    }
+    auto const released{resource.compact()};
+    EXPECT_GT(released, 0);
+    EXPECT_EQ(values.capacity(), 500);
+    EXPECT_EQ(resource.arena().total_size(), 500 * sizeof(std::string));
+
+    ASSERT_EQ(values.size(), 500);
+    for (int i{0}; i < 500; ++i) {
+        EXPECT_EQ(values[i], std::to_string(i));
+    }
+    values.push_back("500");
+    EXPECT_EQ(values.back(), "500");
+    resource.untrack(values);
+}
+TEST(compacting_arena_pmr, vector) {
+    check_vector_compaction<vec<std::string>>();
+}
+TEST(compacting_arena_pmr, vector2) {
+    check_vector_compaction<vec2<std::string>>();
+}
+TEST(compacting_arena_pmr, vector2_trivial_elements) {
+    ml::compacting_arena_pmr resource{1024};
+    vec2<int> values{static_cast<ml::pmr*>(&resource)};
+    resource.track(values);
+
+    for (int i{0}; i < 1000; ++i) {
+        values.push_back(i);
+    }
+    (void)resource.compact();
+    EXPECT_EQ(resource.arena().total_size(), 1000 * sizeof(int));
+    for (int i{0}; i < 1000; ++i) {
+        EXPECT_EQ(values[i], i);
+    }
+    resource.untrack(values);
+}
+TEST(compacting_arena_pmr, binary_heap) {
+    ml::compacting_arena_pmr resource{1024};
+    ml::binary_heap<int> heap{&resource};
+    resource.track(heap);
+
+    for (int i{0}; i < 200; ++i) {
+        heap.insert((i * 37) % 200);
+        resource.deallocate(resource.allocate(64), 64);
+    }
+    // The storage allocates from the resource rather than the default one
+    EXPECT_GT(resource.arena().total_size(), 200 * sizeof(int));
+
+    EXPECT_GT(resource.compact(), 0);
+    EXPECT_EQ(resource.arena().total_size(), 200 * sizeof(int));
+
+    ASSERT_EQ(heap.size(), 200);
+    for (int i{0}; i < 200; ++i) {
+        EXPECT_EQ(heap.pop(), i);
+    }
+    resource.untrack(heap);
+}
+TEST(compacting_arena_pmr, binary_heap_storage_uses_allocator) {
+    std::pmr::monotonic_buffer_resource upstream;
+    ml::binary_heap<int> heap{&upstream};
+    auto* const previous_default{std::pmr::set_default_resource(std::pmr::null_memory_resource())};
+
+    // Allocating from the default resource would throw
+    EXPECT_NO_THROW({
+        for (int i{0}; i < 100; ++i) {
+            heap.insert(i);
+        }
+    });
+    std::pmr::set_default_resource(previous_default);
+}
@@ -0,0 +1,127 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "containers/concurrent_arena_mmr.hpp"
+#include "containers/concurrent_arena_pmr.hpp"
+#include "containers/mmr_allocator.hpp"
+
+#include "configure_warning_pragmas.hpp"
+
+static constexpr std::size_t n_threads{8};
+
+TEST(concurrent_arena, empty_memory_resource) {
+    ml::concurrent_arena_mmr resource;
+    ASSERT_EQ(resource.pool(), nullptr);
+    EXPECT_EQ(resource.n_pools(), 0);
+}
+TEST(concurrent_arena, allocate_with_alignment) {
+    ml::concurrent_arena_mmr resource;
+
+    constexpr std::size_t alignment{64};
+    (void)resource.allocate(3, 1);
+    auto* ptr{resource.allocate(128, alignment)};
+
+    EXPECT_NE(ptr, nullptr);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ptr) % alignment, 0);
+}
+TEST(concurrent_arena, allocate_multiple_pools) {
+    ml::concurrent_arena_mmr resource;
+
+    auto* ptr1{resource.allocate(resource.initial_capacity(), alignof(std::byte))};
+    auto* ptr2{resource.allocate(resource.initial_capacity() * 2, alignof(std::byte))};
+
+    EXPECT_NE(ptr1, ptr2);
+    EXPECT_EQ(resource.n_pools(), 2);
+    EXPECT_EQ(resource.total_size(), resource.initial_capacity() * 3);
+}
+TEST(concurrent_arena, extend_in_place) {
+    ml::concurrent_arena_mmr resource;
+    ml::mmr_allocator<int, ml::concurrent_arena_mmr> alloc{&resource};
+
+    auto const sz{sizeof(int)};
+    auto const ao{alignof(int)};
+
+    auto* ptr1{alloc.allocate_bytes(sz, ao)};
+    auto* ptr2{alloc.extend_bytes(ptr1, sz, sz * 2, ao)};
+
+    EXPECT_EQ(ptr1, ptr2);
+    EXPECT_EQ(resource.total_size(), sz * 2);
+}
+TEST(concurrent_arena, extend_after_other_allocation) {
+    ml::concurrent_arena_mmr resource;
+
+    auto* ptr1{resource.allocate(16, 8)};
+    (void)resource.allocate(16, 8);
+    auto* ptr2{resource.extend(ptr1, 16, 32, 8)};
+
+    EXPECT_NE(ptr1, ptr2);
+}
+TEST(concurrent_arena, threads_get_disjoint_memory) {
+    static constexpr std::size_t allocs_per_thread{2000};
+    static constexpr std::size_t alloc_bytes{24};
+
+    ml::concurrent_arena_mmr resource{256};
+    std::vector<std::vector<std::byte*>> ptrs(n_threads);
+
+    {
+        std::vector<std::jthread> threads;
+        for (std::size_t t{0}; t < n_threads; ++t) {
+            threads.emplace_back([&resource, &ptrs, t]() {
+                for (std::size_t i{0}; i < allocs_per_thread; ++i) {
+                    auto* ptr{static_cast<std::byte*>(resource.allocate(alloc_bytes, 8))};
+                    std::fill_n(ptr, alloc_bytes, static_cast<std::byte>(t));
+                    ptrs[t].push_back(ptr);
+                }
+            });
+        }
+    }
+
+    std::vector<std::byte*> all_ptrs;
+    for (std::size_t t{0}; t < n_threads; ++t) {
+        for (auto* ptr : ptrs[t]) {
+            // Another thread writing over this block would change the pattern
+            EXPECT_TRUE(std::all_of(
+                ptr, ptr + alloc_bytes, [t](auto b) { return b == static_cast<std::byte>(t); }));
+            all_ptrs.push_back(ptr);
+        }
+    }
+
+    std::sort(all_ptrs.begin(), all_ptrs.end());
+    EXPECT_EQ(std::adjacent_find(all_ptrs.begin(), all_ptrs.end()), all_ptrs.end());
+    EXPECT_EQ(resource.total_size(), n_threads * allocs_per_thread * alloc_bytes);
+}
+
+// PMR
+TEST(concurrent_arena_pmr, pmr_vectors_across_threads) {
+    static constexpr int n_elems{5000};
+
+    ml::concurrent_arena_pmr resource;
+    std::vector<std::pmr::vector<int>> vecs;
+    for (std::size_t t{0}; t < n_threads; ++t) {
+        vecs.emplace_back(&resource);
+    }
+
+    {
+        std::vector<std::jthread> threads;
+        for (std::size_t t{0}; t < n_threads; ++t) {
+            threads.emplace_back([&vecs, t]() {
+                for (int i{0}; i < n_elems; ++i) {
+                    vecs[t].push_back(i);
+                }
+            });
+        }
+    }
+
+    for (auto const& vec : vecs) {
+        ASSERT_EQ(vec.size(), n_elems);
+        for (int i{0}; i < n_elems; ++i) {
+            EXPECT_EQ(vec[static_cast<std::size_t>(i)], i);
+        }
+    }
+}
@@ -0,0 +1,151 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "containers/arena_pmr.hpp"
+#include "containers/malloc_pmr.hpp"
+#include "containers/pmr.hpp"
+#include "containers/pmr_allocator.hpp"
+#include "containers/stats_pmr.hpp"
+
+#include "configure_warning_pragmas.hpp"
+
+namespace {
+void fill(void* ptr, std::size_t n_bytes) {
+    auto* bytes{static_cast<unsigned char*>(ptr)};
+    for (std::size_t i{0}; i < n_bytes; ++i) {
+        bytes[i] = static_cast<unsigned char>(i * 7);
+    }
+}
+auto filled(void const* ptr, std::size_t n_bytes) -> bool {
+    auto const* bytes{static_cast<unsigned char const*>(ptr)};
+    for (std::size_t i{0}; i < n_bytes; ++i) {
+        if (bytes[i] != static_cast<unsigned char>(i * 7)) {
+            return false;
+        }
+    }
+    return true;
+}
+}
+
+TEST(malloc_pmr, allocate_and_deallocate) {
+    ml::malloc_pmr resource;
+    constexpr std::size_t large{ml::malloc_pmr::default_mapping_threshold * 2};
+
+    auto* small{resource.allocate(64, alignof(std::max_align_t))};
+    auto* mapped{resource.allocate(large, alignof(std::max_align_t))};
+    fill(small, 64);
+    fill(mapped, large);
+    EXPECT_TRUE(filled(small, 64));
+    EXPECT_TRUE(filled(mapped, large));
+
+    resource.deallocate(small, 64, alignof(std::max_align_t));
+    resource.deallocate(mapped, large, alignof(std::max_align_t));
+}
+TEST(malloc_pmr, over_aligned_allocation) {
+    ml::malloc_pmr resource;
+
+    auto* ptr{resource.allocate(100, 256)};
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ptr) % 256, 0);
+    resource.deallocate(ptr, 100, 256);
+}
+TEST(malloc_pmr, extend_within_usable_size_stays_in_place) {
+    ml::malloc_pmr resource;
+
+    auto* ptr{resource.allocate(20, alignof(std::max_align_t))};
+    auto const usable{resource.usable_size(ptr, 20, alignof(std::max_align_t))};
+    ASSERT_GE(usable, 20);
+
+    EXPECT_EQ(resource.extend(ptr, 20, usable, alignof(std::max_align_t)), ptr);
+    // Shrinking never moves
+    EXPECT_EQ(resource.extend(ptr, usable, 8, alignof(std::max_align_t)), ptr);
+    resource.deallocate(ptr, 8, alignof(std::max_align_t));
+}
+TEST(malloc_pmr, extend_leaves_old_block_to_caller) {
+    ml::malloc_pmr resource;
+
+    auto* ptr{resource.allocate(64, alignof(std::max_align_t))};
+    fill(ptr, 64);
+    auto* new_ptr{resource.extend(ptr, 64, 64 * 1024, alignof(std::max_align_t))};
+    if (new_ptr != ptr) {
+        // Extend never moves the contents, the old block is still valid
+        EXPECT_TRUE(filled(ptr, 64));
+        resource.deallocate(ptr, 64, alignof(std::max_align_t));
+    }
+    resource.deallocate(new_ptr, 64 * 1024, alignof(std::max_align_t));
+}
+TEST(malloc_pmr, reallocate_keeps_contents) {
+    ml::malloc_pmr resource;
+
+    std::size_t size{16};
+    auto* ptr{resource.allocate(size, alignof(std::max_align_t))};
+    fill(ptr, size);
+    // Crosses from malloc into mapped blocks and doubles a few times after that
+    while (size < ml::malloc_pmr::default_mapping_threshold * 8) {
+        ptr = resource.reallocate(ptr, size, size * 2, alignof(std::max_align_t));
+        ASSERT_TRUE(filled(ptr, size));
+        size *= 2;
+        fill(ptr, size);
+    }
+    // And back down again
+    ptr = resource.reallocate(ptr, size, 100, alignof(std::max_align_t));
+    EXPECT_TRUE(filled(ptr, 100));
+    resource.deallocate(ptr, 100, alignof(std::max_align_t));
+}
+TEST(malloc_pmr, reallocate_over_aligned_keeps_alignment) {
+    ml::malloc_pmr resource;
+
+    auto* ptr{resource.allocate(64, 128)};
+    fill(ptr, 64);
+    ptr = resource.reallocate(ptr, 64, 4096, 128);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ptr) % 128, 0);
+    EXPECT_TRUE(filled(ptr, 64));
+    resource.deallocate(ptr, 4096, 128);
+}
+TEST(malloc_pmr, allocator_reallocate) {
+    ml::malloc_pmr resource{4096};
+    ml::pmr_allocator<int> alloc{&resource};
+
+    auto* ints{alloc.allocate(10)};
+    std::iota(ints, ints + 10, 0);
+    ints = alloc.reallocate(ints, 10, 100'000);
+    for (int i{0}; i < 10; ++i) {
+        EXPECT_EQ(ints[i], i);
+    }
+    alloc.deallocate(ints, 100'000);
+}
+TEST(malloc_pmr, equality) {
+    ml::malloc_pmr a;
+    ml::malloc_pmr b;
+    ml::malloc_pmr c{4096};
+
+    EXPECT_TRUE(a.is_equal(b));
+    EXPECT_FALSE(a.is_equal(c));
+}
+
+// The default reallocate extends and copies
+TEST(pmr, default_reallocate_copies_contents) {
+    ml::arena_pmr resource{64};
+
+    auto* ptr{resource.allocate(32)};
+    fill(ptr, 32);
+    (void)resource.allocate(8);
+    auto* new_ptr{static_cast<ml::pmr&>(resource).reallocate(ptr, 32, 256, alignof(std::max_align_t))};
+    EXPECT_NE(new_ptr, ptr);
+    EXPECT_TRUE(filled(new_ptr, 32));
+}
+TEST(stats_pmr, counts_reallocations) {
+    ml::malloc_pmr upstream;
+    ml::stats_pmr resource{&upstream};
+
+    auto* ptr{resource.allocate(64)};
+    ptr = resource.reallocate(ptr, 64, 1 << 20, alignof(std::max_align_t));
+    auto const stats{resource.stats()};
+    EXPECT_EQ(stats.n_extends, 1);
+    EXPECT_EQ(stats.live_bytes, std::size_t{1} << 20);
+    resource.deallocate(ptr, 1 << 20);
+}
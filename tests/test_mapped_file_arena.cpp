@@ -0,0 +1,213 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "containers/mapped_file_allocator.hpp"
+#include "containers/mapped_file_arena_mmr.hpp"
+#include "containers/offset_ptr.hpp"
+#include "containers/vector.hpp"
+
+#include "configure_warning_pragmas.hpp"
+
+namespace {
+// Deletes the file when the test ends
+class temp_file {
+  public:
+    explicit temp_file(char const* name)
+        : path_{std::filesystem::temp_directory_path() / name} {
+        std::filesystem::remove(path_);
+    }
+    ~temp_file() { std::filesystem::remove(path_); }
+
+    auto path() const -> std::filesystem::path const& { return path_; }
+  private:
+    std::filesystem::path path_;
+};
+
+struct node {
+    int value{0};
+    ml::offset_ptr<node> next{};
+};
+
+constexpr ml::mapped_file_options small_options{std::size_t{1} << 24, std::size_t{1} << 12};
+}
+
+// offset_ptr
+TEST(offset_ptr, null_by_default) {
+    ml::offset_ptr<int> ptr;
+    EXPECT_FALSE(ptr);
+    EXPECT_EQ(ptr.get(), nullptr);
+    EXPECT_EQ(ptr, nullptr);
+}
+TEST(offset_ptr, copies_point_at_the_same_target) {
+    int values[4]{1, 2, 3, 4};
+    ml::offset_ptr<int> ptr{&values[1]};
+    std::vector<ml::offset_ptr<int>> copies(10, ptr);
+
+    for (auto const& copy : copies) {
+        EXPECT_EQ(copy.get(), &values[1]);
+    }
+    EXPECT_EQ(*ptr, 2);
+    EXPECT_EQ(ptr[1], 3);
+    EXPECT_EQ(*(ptr + 2), 4);
+    EXPECT_EQ(*++ptr, 3);
+    EXPECT_EQ((ptr - 1).get(), &values[1]);
+    EXPECT_EQ(ptr - ml::offset_ptr<int>{values}, 2);
+    EXPECT_LT(ml::offset_ptr<int>{values}, ptr);
+}
+TEST(offset_ptr, survives_moving_with_its_target) {
+    struct pair {
+        int value{42};
+        ml::offset_ptr<int> ptr{};
+    };
+
+    alignas(pair) std::byte first[sizeof(pair)];
+    alignas(pair) std::byte second[sizeof(pair)];
+    auto* original{new (first) pair{}};
+    original->ptr = &original->value;
+
+    std::memcpy(second, first, sizeof(pair));
+    auto* moved{reinterpret_cast<pair*>(second)};
+    EXPECT_EQ(moved->ptr.get(), &moved->value);
+    EXPECT_EQ(*moved->ptr, 42);
+}
+TEST(offset_ptr, casts) {
+    int value{7};
+    ml::offset_ptr<int> ptr{&value};
+    ml::offset_ptr<void> erased{ptr};
+    ml::offset_ptr<int> restored{erased};
+    ml::offset_ptr<int const> constant{ptr};
+
+    EXPECT_EQ(restored.get(), &value);
+    EXPECT_EQ(constant.get(), &value);
+}
+
+// Arena
+TEST(mapped_file_arena_mmr, creates_a_new_file) {
+    temp_file file{"ml_mapped_file_arena_new.bin"};
+    ml::mapped_file_arena_mmr arena{file.path(), small_options};
+
+    EXPECT_FALSE(arena.reopened());
+    EXPECT_EQ(arena.size(), sizeof(ml::mapped_file_header));
+    EXPECT_EQ(arena.root<void>(), nullptr);
+
+    auto* ptr{arena.allocate(100, 64)};
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ptr) % 64, 0);
+    std::memset(ptr, 1, 100);
+}
+TEST(mapped_file_arena_mmr, grows_the_file) {
+    temp_file file{"ml_mapped_file_arena_grow.bin"};
+    ml::mapped_file_arena_mmr arena{file.path(), small_options};
+
+    auto const initial{arena.capacity()};
+    auto* ptr{static_cast<std::byte*>(arena.allocate(initial * 3, 8))};
+    ptr[initial * 3 - 1] = std::byte{1};
+
+    EXPECT_GE(arena.capacity(), initial * 3);
+    EXPECT_EQ(std::filesystem::file_size(file.path()), arena.capacity());
+}
+TEST(mapped_file_arena_mmr, extend_in_place) {
+    temp_file file{"ml_mapped_file_arena_extend.bin"};
+    ml::mapped_file_arena_mmr arena{file.path(), small_options};
+
+    auto* ptr{arena.allocate(16, 8)};
+    EXPECT_EQ(arena.extend(ptr, 16, 64, 8), ptr);
+    (void)arena.allocate(8, 8);
+    EXPECT_NE(arena.extend(ptr, 64, 128, 8), ptr);
+}
+TEST(mapped_file_arena_mmr, reservation_is_a_hard_limit) {
+    temp_file file{"ml_mapped_file_arena_limit.bin"};
+    ml::mapped_file_arena_mmr arena{file.path(), small_options};
+
+    EXPECT_THROW((void)arena.allocate(arena.reserved(), 8), std::bad_alloc);
+}
+TEST(mapped_file_arena_mmr, linked_nodes_persist) {
+    temp_file file{"ml_mapped_file_arena_nodes.bin"};
+    {
+        ml::mapped_file_arena_mmr arena{file.path(), small_options};
+        auto& head{arena.find_or_make_root<node>()};
+        auto* tail{&head};
+        for (int i{1}; i < 100; ++i) {
+            tail->next = new (arena.allocate(sizeof(node), alignof(node))) node{i};
+            tail = tail->next.get();
+        }
+        arena.sync();
+    }
+
+    ml::mapped_file_arena_mmr arena{file.path(), small_options};
+    EXPECT_TRUE(arena.reopened());
+    int expected{0};
+    for (auto* n{&arena.find_or_make_root<node>()}; n; n = n->next.get()) {
+        EXPECT_EQ(n->value, expected++);
+    }
+    EXPECT_EQ(expected, 100);
+}
+TEST(mapped_file_arena_mmr, std_vector_persists) {
+    using vec_type = std::vector<int, ml::mapped_file_allocator<int>>;
+
+    temp_file file{"ml_mapped_file_arena_vector.bin"};
+    {
+        ml::mapped_file_arena_mmr arena{file.path(), small_options};
+        auto& vec{arena.find_or_make_root<vec_type>(&arena)};
+        for (int i{0}; i < 10'000; ++i) {
+            vec.push_back(i);
+        }
+        arena.sync();
+    }
+
+    ml::mapped_file_arena_mmr arena{file.path(), small_options};
+    ASSERT_TRUE(arena.reopened());
+    auto& vec{arena.find_or_make_root<vec_type>(&arena)};
+    ASSERT_EQ(vec.size(), 10'000);
+    for (int i{0}; i < 10'000; ++i) {
+        EXPECT_EQ(vec[i], i);
+    }
+
+    // The stored allocator finds the reopened arena
+    vec.push_back(10'000);
+    EXPECT_EQ(vec.back(), 10'000);
+}
+TEST(mapped_file_arena_mmr, ml_vector_persists) {
+    using vec_type = ml::vector<int, ml::mapped_file_allocator<int>>;
+
+    temp_file file{"ml_mapped_file_arena_ml_vector.bin"};
+    {
+        ml::mapped_file_arena_mmr arena{file.path(), small_options};
+        auto& vec{arena.find_or_make_root<vec_type>(&arena)};
+        for (int i{0}; i < 10'000; ++i) {
+            vec.push_back(i);
+        }
+        vec.insert(vec.begin(), -1);
+        arena.sync();
+    }
+
+    ml::mapped_file_arena_mmr arena{file.path(), small_options};
+    ASSERT_TRUE(arena.reopened());
+    auto& vec{arena.find_or_make_root<vec_type>(&arena)};
+    ASSERT_EQ(vec.size(), 10'001);
+    EXPECT_EQ(vec.front(), -1);
+    for (int i{0}; i < 10'000; ++i) {
+        EXPECT_EQ(vec[i + 1], i);
+    }
+
+    // Growing after the reopen allocates from the reopened arena
+    vec.append_range(std::vector<int>(vec.capacity(), 7));
+    EXPECT_EQ(vec.back(), 7);
+    EXPECT_GE(vec.data(), static_cast<void*>(arena.header()));
+}
+TEST(mapped_file_arena_mmr, rejects_other_files) {
+    temp_file file{"ml_mapped_file_arena_other.bin"};
+    {
+        std::ofstream out{file.path(), std::ios::binary};
+        std::vector<char> junk(sizeof(ml::mapped_file_header) * 2, 'x');
+        out.write(junk.data(), static_cast<std::streamsize>(junk.size()));
+    }
+
+    EXPECT_THROW((ml::mapped_file_arena_mmr{file.path(), small_options}), std::system_error);
+}
@@ -1,8 +1,16 @@
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <ranges>
+#include <span>
+#include <thread>
+#include <type_traits>
 #include <vector>
 #include <gtest/gtest.h>
 
 #include "containers/multi_arena_pmr.hpp"
+#include "containers/multi_t_arena_mmr.hpp"
 
 #include "configure_warning_pragmas.hpp"
 
@@ -89,6 +97,88 @@ TEST(multi_arena, fill_vectors_with_different_resources) {
         EXPECT_DOUBLE_EQ(double_vec[i], static_cast<double>(i) * 1.1);
     }
 }
+TEST(multi_arena, thread_resource_is_cached) {
+    ml::multi_arena_pmr resource{2, 1024};
+
+    auto* arena{resource.get_thread_resource()};
+    ASSERT_NE(arena, nullptr);
+    EXPECT_EQ(arena, resource.get_thread_resource());
+}
+TEST(multi_arena, thread_resources_are_distinct) {
+    ml::multi_arena_pmr resource{2, 1024};
+
+    auto* main_arena{resource.get_thread_resource()};
+    ml::arena_pmr* other_arena{nullptr};
+    std::jthread([&]() { other_arena = resource.get_thread_resource(); }).join();
+
+    ASSERT_NE(other_arena, nullptr);
+    EXPECT_NE(main_arena, other_arena);
+}
+TEST(multi_arena, thread_resources_are_cache_line_padded) {
+    ml::multi_arena_pmr resource{2, 1024};
+
+    auto const a0{reinterpret_cast<std::uintptr_t>(resource.get_resource(0))};
+    auto const a1{reinterpret_cast<std::uintptr_t>(resource.get_resource(1))};
+    EXPECT_GE(a1 - a0, ml::cache_line_size);
+    EXPECT_EQ(a0 % ml::cache_line_size, 0);
+}
+TEST(multi_arena, thread_exit_releases_arena) {
+    ml::multi_arena_pmr resource{1, 1024};
+
+    for (int i{0}; i < 3; ++i) {
+        std::jthread([&]() {
+            auto* arena{resource.get_thread_resource()};
+            EXPECT_EQ(arena, resource.get_resource(0));
+            EXPECT_NE(arena->allocate(64, 8), nullptr);
+        }).join();
+    }
+}
+TEST(multi_arena, no_free_thread_resource) {
+    ml::multi_arena_pmr resource{1, 1024};
+
+    (void)resource.get_thread_resource();
+    std::jthread([&]() { EXPECT_THROW(resource.get_thread_resource(), std::runtime_error); }).join();
+}
+TEST(multi_arena, thread_resource_per_instance) {
+    ml::multi_arena_pmr resource1{1, 1024};
+    ml::multi_arena_pmr resource2{1, 1024};
+
+    auto* arena1{resource1.get_thread_resource()};
+    auto* arena2{resource2.get_thread_resource()};
+    EXPECT_NE(arena1, arena2);
+    // Switching instances shouldn't claim another arena
+    EXPECT_EQ(arena1, resource1.get_thread_resource());
+    EXPECT_EQ(arena2, resource2.get_thread_resource());
+}
+TEST(multi_arena, cross_thread_deallocation) {
+    ml::multi_arena_pmr resource{2, 1024};
+
+    auto* arena{resource.get_thread_resource()};
+    constexpr std::size_t n_values{100};
+    auto* values{static_cast<int*>(arena->allocate(n_values * sizeof(int), alignof(int)))};
+    std::iota(values, values + n_values, 0);
+
+    std::jthread([&]() {
+        arena->deallocate(values, n_values * sizeof(int), alignof(int));
+        resource.get_thread_resource()->deallocate(values, n_values * sizeof(int), alignof(int));
+    }).join();
+    // The memory stays valid until the allocating thread exits
+    EXPECT_TRUE(std::ranges::equal(std::span(values, n_values), std::views::iota(0, 100)));
+
+    ml::arena_pmr* worker_arena{nullptr};
+    std::jthread([&]() {
+        worker_arena = resource.get_thread_resource();
+        (void)worker_arena->allocate(64, alignof(int));
+        EXPECT_GT(worker_arena->arena().total_size(), 0);
+    }).join();
+    // The worker's pools are released when it exits
+    EXPECT_EQ(worker_arena->arena().total_size(), 0);
+}
+TEST(multi_arena, not_copyable) {
+    static_assert(!std::is_copy_constructible_v<ml::multi_arena_pmr>);
+    static_assert(!std::is_copy_assignable_v<ml::multi_arena_pmr>);
+    static_assert(std::is_move_constructible_v<ml::multi_arena_pmr>);
+}
 
 TEST(multi_t_arena, init) {
     auto resource = ml::multi_t_arena_pmr<int, double, char>{1024};
@@ -99,3 +189,93 @@ TEST(multi_t_arena, get_resource) {
     auto* int_arena = resource.get_resource<int>();
     EXPECT_NE(int_arena, nullptr);
 }
+
+// Monomorphic typed arenas
+namespace {
+struct tree_node {
+    tree_node* left{nullptr};
+    tree_node* right{nullptr};
+    int value{0};
+};
+}
+
+TEST(multi_t_arena_mmr, separate_arena_per_type) {
+    ml::multi_t_arena_mmr<int, double, ml::arena_for<char, 256>> resource;
+
+    EXPECT_NE(static_cast<void*>(resource.get_resource<int>()), static_cast<void*>(resource.get_resource<double>()));
+    EXPECT_EQ(resource.get_resource<char>()->arena().initial_capacity(), 256);
+    EXPECT_EQ(resource.get_resource<int>()->arena().initial_capacity(), 1024);
+
+    auto* i{static_cast<int*>(resource.get_resource<int>()->allocate(sizeof(int), alignof(int)))};
+    auto* d{static_cast<double*>(resource.get_resource<double>()->allocate(sizeof(double), alignof(double)))};
+    *i = 1;
+    *d = 2.0;
+    EXPECT_EQ(resource.get_resource<int>()->arena().total_size(), sizeof(int));
+    EXPECT_EQ(resource.get_resource<double>()->arena().total_size(), sizeof(double));
+    EXPECT_EQ(resource.total_size(), sizeof(int) + sizeof(double));
+}
+TEST(multi_t_arena_mmr, typed_allocators_with_std_vector) {
+    using resource_type = ml::multi_t_arena_mmr<ml::arena_for<int, 4096>, double>;
+    resource_type resource;
+
+    std::vector<int, resource_type::allocator_type<int>> ints{resource.get_allocator<int>()};
+    std::vector<double, resource_type::allocator_type<double>> doubles{resource.get_allocator<double>()};
+    for (int i{0}; i < 100; ++i) {
+        ints.push_back(i);
+        doubles.push_back(i * 0.5);
+    }
+
+    EXPECT_EQ(ints[99], 99);
+    EXPECT_EQ(doubles[99], 49.5);
+    EXPECT_EQ(resource.get_resource<int>()->arena().n_pools(), 1);
+    EXPECT_GT(resource.get_resource<double>()->arena().total_size(), 0);
+}
+TEST(multi_t_arena_mmr, fixed_slots_are_recycled) {
+    ml::multi_t_arena_mmr<ml::arena_for<tree_node, 1024, ml::arena_slot_mode::fixed>> resource;
+    auto alloc{resource.get_allocator<tree_node>()};
+
+    auto* a{alloc.allocate(1)};
+    auto* b{alloc.allocate(1)};
+    alloc.deallocate(a, 1);
+    EXPECT_EQ(resource.get_resource<tree_node>()->n_free_slots(), 1);
+    EXPECT_EQ(alloc.allocate(1), a);
+
+    // Arrays don't use the free list
+    alloc.deallocate(b, 1);
+    auto* array{alloc.allocate(4)};
+    EXPECT_NE(array, b);
+    EXPECT_EQ(resource.get_resource<tree_node>()->n_free_slots(), 1);
+
+    auto const size{resource.total_size()};
+    for (int i{0}; i < 100; ++i) {
+        alloc.deallocate(alloc.allocate(1), 1);
+    }
+    EXPECT_EQ(resource.total_size(), size);
+}
+TEST(multi_t_arena_mmr, fixed_slots_are_aligned_for_the_type) {
+    ml::multi_t_arena_mmr<ml::arena_for<tree_node, 1024, ml::arena_slot_mode::fixed>> resource;
+    auto* arena{resource.get_resource<tree_node>()};
+
+    // Knock the bump pointer off alignment, then ask for a slot with weaker alignment than the type's
+    (void)arena->allocate(1, 1);
+    auto* slot{arena->allocate(sizeof(tree_node), 1)};
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(slot) % alignof(tree_node), 0);
+
+    // The recycled slot comes back as a properly aligned node
+    arena->deallocate(slot, sizeof(tree_node), 1);
+    auto alloc{resource.get_allocator<tree_node>()};
+    auto* node{alloc.allocate(1)};
+    EXPECT_EQ(static_cast<void*>(node), slot);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(node) % alignof(tree_node), 0);
+}
+TEST(multi_t_arena_mmr, reset) {
+    ml::multi_t_arena_mmr<int, ml::arena_for<tree_node, 1024, ml::arena_slot_mode::fixed>> resource;
+    (void)resource.get_allocator<int>().allocate(10);
+    auto node_alloc{resource.get_allocator<tree_node>()};
+    node_alloc.deallocate(node_alloc.allocate(1), 1);
+
+    resource.reset();
+    EXPECT_EQ(resource.total_size(), 0);
+    EXPECT_EQ(resource.get_resource<tree_node>()->n_free_slots(), 0);
+    EXPECT_EQ(resource.total_capacity(), 2048);
+}
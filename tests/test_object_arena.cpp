@@ -0,0 +1,95 @@
+#include <cstddef>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "containers/object_arena_pmr.hpp"
+
+#include "configure_warning_pragmas.hpp"
+
+namespace {
+// Appends its id to a log when destroyed
+struct logged {
+    logged(std::vector<int>* log, int id)
+        : log_{log}
+        , id_{id} {}
+    ~logged() { log_->push_back(id_); }
+
+    std::vector<int>* log_;
+    int id_;
+};
+struct counted {
+    static inline int n_destroyed{0};
+    ~counted() { ++n_destroyed; }
+};
+}
+
+TEST(object_arena_pmr, trivially_destructible_objects_are_not_registered) {
+    ml::object_arena_pmr resource{1024};
+
+    auto& value{resource.make<int>(5)};
+    auto* values{resource.make_array<double>(10)};
+    EXPECT_EQ(value, 5);
+    EXPECT_EQ(values[9], 0.0);
+    EXPECT_EQ(resource.n_destructors(), 0);
+}
+TEST(object_arena_pmr, reset_destroys_in_reverse_order) {
+    std::vector<int> log;
+    ml::object_arena_pmr resource{1024};
+
+    for (int i{0}; i < 200; ++i) {
+        (void)resource.make<logged>(&log, i);
+    }
+    EXPECT_EQ(resource.n_destructors(), 200);
+
+    resource.reset();
+    ASSERT_EQ(log.size(), 200);
+    for (int i{0}; i < 200; ++i) {
+        EXPECT_EQ(log[i], 199 - i);
+    }
+    EXPECT_EQ(resource.n_destructors(), 0);
+    EXPECT_EQ(resource.arena().total_size(), 0);
+}
+TEST(object_arena_pmr, destructor_destroys_objects) {
+    counted::n_destroyed = 0;
+    {
+        ml::object_arena_pmr resource{1024};
+        (void)resource.make<counted>();
+        (void)resource.make_array<counted>(9);
+    }
+    EXPECT_EQ(counted::n_destroyed, 10);
+}
+TEST(object_arena_pmr, rewind_destroys_newer_objects) {
+    std::vector<int> log;
+    ml::object_arena_pmr resource{1024};
+
+    (void)resource.make<logged>(&log, 0);
+    auto const m{resource.mark()};
+    for (int i{1}; i < 100; ++i) {
+        (void)resource.make<logged>(&log, i);
+    }
+
+    resource.rewind(m);
+    EXPECT_EQ(log.size(), 99);
+    EXPECT_EQ(log.front(), 99);
+    EXPECT_EQ(resource.n_destructors(), 1);
+
+    // Registration carries on from the mark
+    (void)resource.make<logged>(&log, 100);
+    log.clear();
+    resource.reset();
+    EXPECT_EQ(log, (std::vector<int>{100, 0}));
+}
+TEST(object_arena_pmr, objects_allocating_from_the_arena) {
+    ml::object_arena_pmr resource{4096};
+
+    auto& strings{resource.make<std::pmr::vector<std::pmr::string>>(&resource)};
+    for (int i{0}; i < 100; ++i) {
+        strings.emplace_back("a string long enough to need its own allocation");
+    }
+    EXPECT_EQ(resource.n_destructors(), 1);
+    EXPECT_EQ(strings.back(), "a string long enough to need its own allocation");
+    resource.reset();
+}
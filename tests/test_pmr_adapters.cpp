@@ -0,0 +1,69 @@
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "size_checking_resource.hpp"
+
+#include "containers/arena_pmr.hpp"
+#include "containers/new_delete_pmr.hpp"
+#include "containers/pmr.hpp"
+#include "containers/pmr_adapters.hpp"
+#include "containers/pmr_allocator.hpp"
+#include "containers/vector.hpp"
+
+#include "configure_warning_pragmas.hpp"
+
+TEST(std_pmr_adapter, std_vector_on_ml_pmr) {
+    ml::new_delete_pmr<ml::pmr> upstream;
+    ml::std_pmr_adapter adapter{&upstream};
+    std::pmr::vector<int> values{&adapter};
+
+    for (int i{0}; i < 100; ++i) {
+        values.push_back(i);
+    }
+    EXPECT_EQ(values.back(), 99);
+}
+TEST(std_pmr_adapter, equality_follows_upstream) {
+    ml::new_delete_pmr<ml::pmr> upstream;
+    ml::new_delete_pmr<ml::pmr> other_upstream;
+    ml::std_pmr_adapter adapter1{&upstream};
+    ml::std_pmr_adapter adapter2{&upstream};
+    ml::std_pmr_adapter adapter3{&other_upstream};
+
+    EXPECT_TRUE(adapter1.is_equal(adapter2));
+    EXPECT_FALSE(adapter1.is_equal(adapter3));
+}
+TEST(ml_pmr_adapter, keeps_extend_of_upstream) {
+    ml::arena_pmr upstream;
+    ml::ml_pmr_adapter adapter{&upstream};
+    EXPECT_TRUE(adapter.can_extend());
+
+    auto* ptr1{adapter.allocate(16, alignof(int))};
+    EXPECT_EQ(adapter.extend(ptr1, 16, 32, alignof(int)), ptr1);
+}
+TEST(ml_pmr_adapter, extend_falls_back_to_allocate) {
+    std::pmr::monotonic_buffer_resource upstream;
+    ml::ml_pmr_adapter adapter{&upstream};
+    EXPECT_FALSE(adapter.can_extend());
+
+    auto* ptr1{adapter.allocate(16, alignof(int))};
+    EXPECT_NE(adapter.extend(ptr1, 16, 8, alignof(int)), ptr1);
+    EXPECT_NE(adapter.extend(ptr1, 16, 32, alignof(int)), ptr1);
+}
+
+TEST(ml_pmr_adapter, shrink_to_fit_deallocates_with_allocated_size) {
+    size_checking_resource upstream;
+    ml::ml_pmr_adapter adapter{&upstream};
+    {
+        ml::vector<int, ml::pmr_allocator<int>> values{&adapter};
+        values.reserve(100);
+        values.push_back(1);
+        values.push_back(2);
+        values.shrink_to_fit();
+        EXPECT_EQ(values.capacity(), 2);
+        EXPECT_EQ(values[0], 1);
+        EXPECT_EQ(values[1], 2);
+    }
+}
@@ -0,0 +1,131 @@
+#include <cstddef>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "containers/compacting_arena_pmr.hpp"
+#include "containers/linked_vector.hpp"
+#include "containers/pmr_allocator.hpp"
+#include "containers/relocation.hpp"
+
+#include "configure_warning_pragmas.hpp"
+
+namespace {
+// Counts the calls which a bitwise relocation skips
+struct counted {
+    static inline int n_moves{0};
+    static inline int n_destroyed{0};
+
+    counted(int v)
+        : value{v} {}
+    counted(counted const& other) = default;
+    counted(counted&& other) noexcept
+        : value{other.value} {
+        ++n_moves;
+    }
+    ~counted() { ++n_destroyed; }
+
+    static void reset() {
+        n_moves = 0;
+        n_destroyed = 0;
+    }
+
+    int value;
+};
+struct relocatable_counted : counted {
+    using counted::counted;
+};
+}
+
+template <>
+struct ml::is_trivially_relocatable<relocatable_counted> : std::true_type {};
+
+TEST(relocation, trait_defaults) {
+    static_assert(ml::is_trivially_relocatable_v<int>);
+    static_assert(ml::is_trivially_relocatable_v<int const>);
+    static_assert(!ml::is_trivially_relocatable_v<std::string>);
+    static_assert(!ml::is_trivially_relocatable_v<counted>);
+    static_assert(ml::is_trivially_relocatable_v<relocatable_counted>);
+}
+TEST(relocation, relocate_moves_and_destroys) {
+    alignas(counted) std::byte source_buffer[sizeof(counted) * 3];
+    alignas(counted) std::byte dest_buffer[sizeof(counted) * 3];
+    auto* source{reinterpret_cast<counted*>(source_buffer)};
+    auto* dest{reinterpret_cast<counted*>(dest_buffer)};
+    for (int i{0}; i < 3; ++i) {
+        new (source + i) counted{i};
+    }
+
+    counted::reset();
+    ml::relocate(source, 3, dest);
+    EXPECT_EQ(counted::n_moves, 3);
+    EXPECT_EQ(counted::n_destroyed, 3);
+    for (int i{0}; i < 3; ++i) {
+        EXPECT_EQ(dest[i].value, i);
+        dest[i].~counted();
+    }
+}
+TEST(relocation, relocate_overlapping_both_directions) {
+    alignas(counted) std::byte buffer[sizeof(counted) * 5];
+    auto* objects{reinterpret_cast<counted*>(buffer)};
+    for (int i{0}; i < 3; ++i) {
+        new (objects + i) counted{i};
+    }
+
+    // Up by two, then back down by one
+    ml::relocate_overlapping(objects, 3, objects + 2);
+    for (int i{0}; i < 3; ++i) {
+        EXPECT_EQ(objects[i + 2].value, i);
+    }
+    ml::relocate_overlapping(objects + 2, 3, objects + 1);
+    for (int i{0}; i < 3; ++i) {
+        EXPECT_EQ(objects[i + 1].value, i);
+        objects[i + 1].~counted();
+    }
+}
+TEST(relocation, relocate_specialised_type_is_bitwise) {
+    alignas(relocatable_counted) std::byte source_buffer[sizeof(relocatable_counted) * 3];
+    alignas(relocatable_counted) std::byte dest_buffer[sizeof(relocatable_counted) * 3];
+    auto* source{reinterpret_cast<relocatable_counted*>(source_buffer)};
+    auto* dest{reinterpret_cast<relocatable_counted*>(dest_buffer)};
+    for (int i{0}; i < 3; ++i) {
+        new (source + i) relocatable_counted{i};
+    }
+
+    counted::reset();
+    ml::relocate(source, 3, dest);
+    EXPECT_EQ(counted::n_moves, 0);
+    EXPECT_EQ(counted::n_destroyed, 0);
+    for (int i{0}; i < 3; ++i) {
+        EXPECT_EQ(dest[i].value, i);
+        dest[i].~relocatable_counted();
+    }
+}
+TEST(relocation, copy_construct) {
+    std::string const source[]{"a", "bb", "ccc"};
+    alignas(std::string) std::byte dest_buffer[sizeof(std::string) * 3];
+    auto* dest{reinterpret_cast<std::string*>(dest_buffer)};
+
+    ml::copy_construct(source, 3, dest);
+    for (int i{0}; i < 3; ++i) {
+        EXPECT_EQ(dest[i], source[i]);
+        dest[i].~basic_string();
+    }
+}
+TEST(relocation, linked_vector_compact_is_bitwise) {
+    ml::compacting_arena_pmr resource{1024};
+    ml::linked_vector<relocatable_counted, ml::pmr_allocator<std::byte>> values{&resource};
+    for (int i{0}; i < 100; ++i) {
+        values.emplace_back(i);
+    }
+
+    counted::reset();
+    values.compact();
+    EXPECT_EQ(counted::n_moves, 0);
+    EXPECT_EQ(counted::n_destroyed, 0);
+
+    int i{0};
+    for (auto const& value : values) {
+        EXPECT_EQ(value.value, i++);
+    }
+}
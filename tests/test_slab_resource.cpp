@@ -0,0 +1,250 @@
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory_resource>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "containers/dlist.hpp"
+#include "containers/mmr_allocator.hpp"
+#include "containers/pmr.hpp"
+#include "containers/pmr_allocator.hpp"
+#include "containers/slab_mmr.hpp"
+#include "containers/slab_pmr.hpp"
+
+#include "configure_warning_pragmas.hpp"
+
+TEST(slab_mmr, size_classes) {
+    EXPECT_EQ(ml::slab_mmr::block_size(1, 1), ml::slab_mmr::min_block_size);
+    EXPECT_EQ(ml::slab_mmr::block_size(24, 8), 32);
+    EXPECT_EQ(ml::slab_mmr::block_size(8, 64), 64);
+    EXPECT_EQ(ml::slab_mmr::size_class(ml::slab_mmr::min_block_size), 0);
+    EXPECT_EQ(ml::slab_mmr::size_class(ml::slab_mmr::max_block_size), ml::slab_mmr::n_size_classes - 1);
+}
+TEST(slab_mmr, free_block_is_reused) {
+    ml::slab_mmr resource;
+
+    auto* ptr{resource.allocate(24, 8)};
+    resource.deallocate(ptr, 24, 8);
+    // Same size class
+    EXPECT_EQ(resource.allocate(32, 8), ptr);
+}
+TEST(slab_mmr, size_classes_do_not_share_blocks) {
+    ml::slab_mmr resource;
+
+    auto* small{resource.allocate(16, 8)};
+    resource.deallocate(small, 16, 8);
+    auto* large{resource.allocate(64, 8)};
+
+    EXPECT_NE(small, large);
+}
+TEST(slab_mmr, alignment) {
+    ml::slab_mmr resource;
+
+    (void)resource.allocate(8, 8);
+    for (std::size_t alignment{8}; alignment <= ml::slab_mmr::max_block_size; alignment *= 2) {
+        auto* ptr{resource.allocate(8, alignment)};
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ptr) % alignment, 0);
+    }
+}
+TEST(slab_mmr, chunks_are_refilled) {
+    ml::slab_mmr resource{ml::slab_mmr::max_block_size};
+
+    std::vector<void*> ptrs;
+    for (int i{0}; i < 1000; ++i) {
+        auto* ptr{static_cast<int*>(resource.allocate(sizeof(int), alignof(int)))};
+        *ptr = i;
+        ptrs.push_back(ptr);
+    }
+    EXPECT_GT(resource.n_chunks(), 1);
+
+    for (int i{0}; i < 1000; ++i) {
+        EXPECT_EQ(*static_cast<int*>(ptrs[i]), i);
+    }
+}
+TEST(slab_mmr, large_allocation_bypasses_chunks) {
+    ml::slab_mmr resource;
+
+    constexpr std::size_t n_bytes{ml::slab_mmr::max_block_size * 4};
+    auto* ptr{resource.allocate(n_bytes, 8)};
+    EXPECT_EQ(resource.n_chunks(), 0);
+    resource.deallocate(ptr, n_bytes, 8);
+}
+TEST(slab_mmr, extend_within_size_class) {
+    ml::slab_mmr resource;
+
+    auto* ptr{resource.allocate(20, 4)};
+    EXPECT_EQ(resource.extend(ptr, 20, 32, 4), ptr);
+    EXPECT_NE(resource.extend(ptr, 32, 33, 4), ptr);
+}
+TEST(slab_mmr, move) {
+    ml::slab_mmr resource;
+    auto* ptr{resource.allocate(16, 8)};
+    resource.deallocate(ptr, 16, 8);
+
+    ml::slab_mmr moved{std::move(resource)};
+    EXPECT_EQ(moved.n_chunks(), 1);
+    EXPECT_EQ(resource.n_chunks(), 0);
+    EXPECT_EQ(moved.allocate(16, 8), ptr);
+}
+TEST(slab_mmr, std_vector_of_nodes) {
+    ml::slab_mmr resource;
+    ml::mmr_allocator<int, ml::slab_mmr> alloc{&resource};
+
+    std::vector<int*> nodes;
+    for (int i{0}; i < 100; ++i) {
+        nodes.push_back(alloc.allocate(1));
+    }
+    for (auto* node : nodes) {
+        alloc.deallocate(node, 1);
+    }
+    for (int i{0}; i < 100; ++i) {
+        (void)alloc.allocate(1);
+    }
+    EXPECT_EQ(resource.n_chunks(), 1);
+}
+
+// Remote frees
+TEST(slab_mmr, remote_free_is_reused) {
+    ml::slab_mmr resource;
+
+    auto* ptr{resource.allocate(24, 8)};
+    std::thread{[&] { resource.deallocate(ptr, 24, 8); }}.join();
+    EXPECT_EQ(resource.allocate(32, 8), ptr);
+}
+TEST(slab_mmr, remote_frees_from_many_threads) {
+    constexpr int n_threads{4};
+    constexpr int n_per_thread{1000};
+
+    ml::slab_mmr resource;
+    std::vector<std::vector<void*>> blocks(n_threads);
+    for (auto& thread_blocks : blocks) {
+        for (int i{0}; i < n_per_thread; ++i) {
+            thread_blocks.push_back(resource.allocate(16, 8));
+        }
+    }
+    auto const n_chunks{resource.n_chunks()};
+
+    std::vector<std::thread> threads;
+    for (auto& thread_blocks : blocks) {
+        threads.emplace_back([&resource, &thread_blocks] {
+            for (auto* ptr : thread_blocks) {
+                resource.deallocate(ptr, 16, 8);
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    // Every block comes back without carving new chunks
+    for (int i{0}; i < n_threads * n_per_thread; ++i) {
+        (void)resource.allocate(16, 8);
+    }
+    EXPECT_EQ(resource.n_chunks(), n_chunks);
+}
+TEST(slab_mmr, claim) {
+    ml::slab_mmr resource;
+
+    std::thread{[&] {
+        EXPECT_FALSE(resource.is_owner());
+        resource.claim();
+        EXPECT_TRUE(resource.is_owner());
+        auto* ptr{resource.allocate(16, 8)};
+        resource.deallocate(ptr, 16, 8);
+        EXPECT_EQ(resource.allocate(16, 8), ptr);
+    }}.join();
+}
+TEST(slab_mmr, move_keeps_remote_frees) {
+    ml::slab_mmr resource;
+
+    auto* ptr{resource.allocate(16, 8)};
+    resource.deallocate_remote(ptr, 16, 8);
+
+    ml::slab_mmr moved{std::move(resource)};
+    EXPECT_EQ(moved.allocate(16, 8), ptr);
+}
+TEST(slab_mmr, owner_identity_is_not_reused) {
+    ml::slab_mmr resource;
+    std::thread{[&] { resource.claim(); }}.join();
+
+    // A later thread may get the exited owner's stack and thread_local storage
+    std::thread{[&] { EXPECT_FALSE(resource.is_owner()); }}.join();
+    EXPECT_FALSE(resource.is_owner());
+}
+
+// Polymorphic flavours
+TEST(slab_pmr, std_pmr_list_churn) {
+    ml::slab_pmr<std::pmr::memory_resource> resource;
+    std::pmr::list<int> values{&resource};
+
+    for (int round{0}; round < 10; ++round) {
+        for (int i{0}; i < 1000; ++i) {
+            values.push_back(i);
+        }
+        values.clear();
+    }
+
+    // Nodes freed in one round are reused in the next
+    auto const n_chunks{resource.slab().n_chunks()};
+    for (int i{0}; i < 1000; ++i) {
+        values.push_back(i);
+    }
+    EXPECT_EQ(resource.slab().n_chunks(), n_chunks);
+}
+TEST(slab_pmr, dlist_churn) {
+    using list_type = ml::dlist<int, ml::pmr_allocator>;
+
+    ml::slab_pmr<ml::pmr> resource;
+    list_type values{list_type::allocator_type{&resource}};
+
+    for (int i{0}; i < 100; ++i) {
+        values.push_back(i);
+    }
+    auto const n_chunks{resource.slab().n_chunks()};
+
+    for (int i{0}; i < 10'000; ++i) {
+        values.pop_front();
+        values.push_back(i);
+    }
+
+    EXPECT_EQ(values.size(), 100);
+    EXPECT_EQ(values.back(), 9'999);
+    EXPECT_EQ(resource.slab().n_chunks(), n_chunks);
+    values.clear();
+}
+TEST(slab_pmr, handed_to_worker) {
+    ml::slab_pmr<std::pmr::memory_resource> resource;
+    void* ptr{nullptr};
+
+    std::thread{[&] {
+        EXPECT_FALSE(resource.is_owner());
+        resource.claim();
+        EXPECT_TRUE(resource.is_owner());
+
+        std::pmr::list<int> values{&resource};
+        for (int i{0}; i < 1000; ++i) {
+            values.push_back(i);
+        }
+        values.clear();
+        ptr = resource.allocate(16, 8);
+    }}.join();
+
+    // The constructing thread no longer owns it so its frees go to the remote lists
+    EXPECT_FALSE(resource.is_owner());
+    resource.deallocate(ptr, 16, 8);
+
+    std::thread{[&] {
+        resource.claim();
+        EXPECT_EQ(resource.allocate(16, 8), ptr);
+    }}.join();
+}
+TEST(slab_pmr, ml_pmr_extend) {
+    ml::slab_pmr<ml::pmr> resource;
+    ml::pmr& base{resource};
+
+    auto* ptr{base.allocate(12, 4)};
+    EXPECT_EQ(base.extend(ptr, 12, 16, 4), ptr);
+}
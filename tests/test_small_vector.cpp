@@ -0,0 +1,207 @@
+#include <algorithm>
+#include <cstddef>
+#include <memory_resource>
+#include <numeric>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "test_container_single_elem_iterators.hpp"
+#include "test_vector.hpp"
+#include "vector_container_traits.hpp"
+
+#include "containers/buffer_pmr.hpp"
+#include "containers/new_delete_pmr.hpp"
+#include "containers/pmr_allocator.hpp"
+#include "containers/small_vector.hpp"
+
+#include "configure_warning_pragmas.hpp"
+
+TEST(small_vector, starts_inline) {
+    ml::small_vector<int, 4> values;
+    EXPECT_TRUE(values.is_inline());
+    EXPECT_EQ(values.capacity(), 4);
+    EXPECT_EQ(values.size(), 0);
+}
+TEST(small_vector, stays_inline_up_to_capacity) {
+    ml::small_vector<std::string, 4> values;
+    for (int i{0}; i < 4; ++i) {
+        values.push_back(std::to_string(i));
+    }
+    EXPECT_TRUE(values.is_inline());
+    EXPECT_EQ(values.back(), "3");
+}
+TEST(small_vector, spills_to_heap) {
+    ml::small_vector<std::string, 4> values;
+    for (int i{0}; i < 5; ++i) {
+        values.push_back(std::to_string(i));
+    }
+    EXPECT_FALSE(values.is_inline());
+    EXPECT_EQ(values.capacity(), 8);
+    for (int i{0}; i < 5; ++i) {
+        EXPECT_EQ(values[i], std::to_string(i));
+    }
+}
+TEST(small_vector, shrink_to_fit_moves_back_inline) {
+    ml::small_vector<std::string, 4> values{"a", "b", "c", "d", "e", "f"};
+    EXPECT_FALSE(values.is_inline());
+
+    values.pop_back();
+    values.shrink_to_fit();
+    EXPECT_FALSE(values.is_inline());
+    EXPECT_EQ(values.capacity(), 5);
+
+    values.pop_back();
+    values.pop_back();
+    values.shrink_to_fit();
+    EXPECT_TRUE(values.is_inline());
+    EXPECT_TRUE(std::ranges::equal(values, std::vector<std::string>{"a", "b", "c"}));
+}
+TEST(small_vector, copy) {
+    ml::small_vector<std::string, 2> inline_values{"a"};
+    ml::small_vector<std::string, 2> heap_values{"a", "b", "c"};
+
+    auto inline_copy{inline_values};
+    auto heap_copy{heap_values};
+    EXPECT_TRUE(inline_copy.is_inline());
+    EXPECT_TRUE(std::ranges::equal(inline_copy, inline_values));
+    EXPECT_TRUE(std::ranges::equal(heap_copy, heap_values));
+
+    inline_copy = heap_values;
+    EXPECT_TRUE(std::ranges::equal(inline_copy, heap_values));
+}
+TEST(small_vector, move_inline) {
+    ml::small_vector<std::string, 4> values{"a", "b"};
+    auto moved{std::move(values)};
+    EXPECT_TRUE(moved.is_inline());
+    EXPECT_TRUE(std::ranges::equal(moved, std::vector<std::string>{"a", "b"}));
+    EXPECT_TRUE(values.empty());
+}
+TEST(small_vector, move_heap_takes_block) {
+    ml::small_vector<std::string, 2> values{"a", "b", "c"};
+    auto const* data{values.data()};
+    auto moved{std::move(values)};
+    EXPECT_EQ(moved.data(), data);
+    EXPECT_TRUE(values.empty());
+    EXPECT_TRUE(values.is_inline());
+
+    ml::small_vector<std::string, 2> target{"x", "y", "z", "w"};
+    target = std::move(moved);
+    EXPECT_EQ(target.data(), data);
+    EXPECT_TRUE(std::ranges::equal(target, std::vector<std::string>{"a", "b", "c"}));
+}
+TEST(small_vector, move_assign_unequal_allocators) {
+    std::pmr::monotonic_buffer_resource resource_a;
+    std::pmr::monotonic_buffer_resource resource_b;
+    using Vector = ml::small_vector<std::string, 1, std::pmr::polymorphic_allocator<std::string>>;
+    Vector a(&resource_a);
+    Vector b(&resource_b);
+    b.push_back("x");
+    b.push_back("y");
+    a = std::move(b);
+    EXPECT_TRUE(std::ranges::equal(a, std::vector<std::string>{"x", "y"}));
+}
+TEST(small_vector, insert_erase_resize) {
+    ml::small_vector<int, 4> values{0, 2};
+    values.insert(values.begin() + 1, 1);
+    values.append_range(std::vector{3, 4, 5});
+    EXPECT_TRUE(std::ranges::equal(values, std::views::iota(0, 6)));
+
+    values.erase(values.begin(), values.begin() + 2);
+    EXPECT_TRUE(std::ranges::equal(values, std::views::iota(2, 6)));
+
+    values.resize(6);
+    EXPECT_EQ(values.back(), 0);
+    values.resize(2);
+    EXPECT_TRUE(std::ranges::equal(values, std::vector{2, 3}));
+}
+TEST(small_vector, emplace_back_own_element_when_full) {
+    ml::small_vector<std::string, 2> values{"a", "b"};
+    values.emplace_back(values[0]);
+    EXPECT_FALSE(values.is_inline());
+    EXPECT_TRUE(std::ranges::equal(values, std::vector<std::string>{"a", "b", "a"}));
+}
+TEST(small_vector, insert_own_element) {
+    ml::small_vector<std::string, 4> values{"a", "b", "c"};
+    values.insert(values.begin(), values[2]);
+    EXPECT_TRUE(std::ranges::equal(values, std::vector<std::string>{"c", "a", "b", "c"}));
+    values.insert(values.begin(), values[3]);
+    EXPECT_FALSE(values.is_inline());
+    EXPECT_TRUE(std::ranges::equal(values, std::vector<std::string>{"c", "c", "a", "b", "c"}));
+}
+TEST(small_vector, resize_from_own_element) {
+    ml::small_vector<std::string, 2> values{"a", "b"};
+    values.resize(5, values[0]);
+    EXPECT_TRUE(std::ranges::equal(values, std::vector<std::string>{"a", "b", "a", "a", "a"}));
+}
+TEST(small_vector, insert_range) {
+    ml::small_vector<std::string, 4> values{"a", "d"};
+    auto it{values.insert_range(values.begin() + 1, std::vector<std::string>{"b", "c"})};
+    EXPECT_EQ(*it, "b");
+    EXPECT_TRUE(values.is_inline());
+    values.insert_range(values.end(), std::vector<std::string>{"e", "f"});
+    EXPECT_FALSE(values.is_inline());
+    EXPECT_TRUE(std::ranges::equal(values, std::vector<std::string>{"a", "b", "c", "d", "e", "f"}));
+}
+TEST(small_vector, assign_range) {
+    ml::small_vector<std::string, 2> values{"x"};
+    values.assign_range(std::vector<std::string>{"a", "b", "c"});
+    EXPECT_TRUE(std::ranges::equal(values, std::vector<std::string>{"a", "b", "c"}));
+    values.assign_range(std::vector<std::string>{"d"});
+    EXPECT_TRUE(std::ranges::equal(values, std::vector<std::string>{"d"}));
+}
+TEST(small_vector, resize_for_overwrite_and_fill) {
+    ml::small_vector<int, 4> values;
+    values.resize_for_overwrite(3);
+    std::iota(values.begin(), values.end(), 0);
+    auto const n_written{values.reserve_and_fill(10, [](int* p, std::size_t n) {
+        std::iota(p, p + n / 2, 3);
+        return n / 2;
+    })};
+    EXPECT_EQ(n_written, 5);
+    EXPECT_TRUE(std::ranges::equal(values, std::views::iota(0, 8)));
+}
+TEST(small_vector, compact) {
+    ml::small_vector<int, 2> values{0, 1, 2, 3};
+    values.reserve(100);
+    values.compact();
+    EXPECT_EQ(values.capacity(), 4);
+    values.resize(2);
+    values.compact();
+    EXPECT_TRUE(values.is_inline());
+    EXPECT_TRUE(std::ranges::equal(values, std::vector{0, 1}));
+}
+
+template <typename T, std::size_t N, typename Allocator>
+struct ContainerTestTraits<ml::small_vector<T, N, Allocator>>
+    : vector_container_traits<ml::small_vector<T, N, Allocator>> {
+    using Container = ml::small_vector<T, N, Allocator>;
+    using vector_container_traits<Container>::add_element;
+    using vector_container_traits<Container>::add_elements;
+    using vector_container_traits<Container>::emplace_element;
+};
+
+using T0 = ml::small_vector<int, 2>;
+using TT0 = ContainerDefinition<T0, []() { return std::make_tuple(T0()); }>;
+using T1 = ml::small_vector<int, 16>;
+using TT1 = ContainerDefinition<T1, []() { return std::make_tuple(T1()); }>;
+
+using T2 = ml::small_vector<int, 2, ml::pmr_allocator<int>>;
+using TT2 = ContainerDefinition<T2, []() {
+    return std::make_tuple(T2(ml::get_new_delete_pmr<ml::pmr>()));
+}>;
+
+using T3 = ml::small_vector<int, 2, ml::pmr_allocator<int>>;
+using TT3 = ContainerDefinition<T3, []() {
+    using Resource = ml::buffer_pmr<int, 1000, ml::pmr>;
+    auto resource{std::make_unique<Resource>()};
+    auto values{T3{resource.get()}};
+
+    return std::make_tuple(std::move(values), std::move(resource));
+}>;
+
+using TestTypes = ::testing::Types<TT0, TT1, TT2, TT3>;
+INSTANTIATE_TYPED_TEST_SUITE_P(small_vector_, ContainerSingleElemIteratorTest, TestTypes);
+INSTANTIATE_TYPED_TEST_SUITE_P(small_vector_, VectorTest, TestTypes);
@@ -89,3 +89,135 @@ TEST(stack_pmr, pop_out_of_order) {
         }
     }
 }
+TEST(stack_pmr, allocate_without_reserve) {
+    ml::stack_pmr stack;
+    {
+        auto frame(stack.create_frame());
+        EXPECT_EQ(stack.n_segments(), 1);
+        EXPECT_EQ(sizeof(ml::stack_pmr_frame), stack.size());
+    }
+    EXPECT_EQ(0, stack.size());
+}
+TEST(stack_pmr, overflow_chains_segment) {
+    ml::stack_pmr stack;
+    stack.reserve(128);
+
+    auto frame(stack.create_frame());
+    std::pmr::vector<int> vec{frame.get()};
+    for (int i{0}; i < 1000; ++i) {
+        vec.push_back(i);
+    }
+
+    EXPECT_GT(stack.n_segments(), 1);
+    EXPECT_GT(stack.capacity(), 128);
+    EXPECT_EQ(vec.back(), 999);
+}
+TEST(stack_pmr, pop_rewinds_across_segments) {
+    ml::stack_pmr stack;
+    stack.reserve(256);
+
+    {
+        auto frame0(stack.create_frame());
+        auto const size0{stack.size()};
+        {
+            auto frame1(stack.create_frame());
+            (void)frame1->allocate(1024, 8);
+            EXPECT_EQ(stack.n_segments(), 2);
+        }
+        EXPECT_EQ(stack.size(), size0);
+    }
+    EXPECT_EQ(stack.size(), 0);
+}
+TEST(stack_pmr, spare_segments_are_reused) {
+    ml::stack_pmr stack;
+    stack.reserve(256);
+
+    for (int round{0}; round < 5; ++round) {
+        auto frame(stack.create_frame());
+        (void)frame->allocate(1024, 8);
+        (void)frame->allocate(1024, 8);
+    }
+
+    auto const n_segments{stack.n_segments()};
+    auto const capacity{stack.capacity()};
+    {
+        auto frame(stack.create_frame());
+        (void)frame->allocate(1024, 8);
+        (void)frame->allocate(1024, 8);
+    }
+    EXPECT_EQ(stack.n_segments(), n_segments);
+    EXPECT_EQ(stack.capacity(), capacity);
+}
+TEST(stack_pmr, upstream_resource) {
+    std::pmr::monotonic_buffer_resource upstream;
+    ml::stack_pmr stack{&upstream};
+    EXPECT_EQ(stack.upstream(), &upstream);
+
+    auto frame(stack.create_frame());
+    (void)frame->allocate(4096, 8);
+    EXPECT_EQ(stack.n_segments(), 2);
+}
+TEST(stack_pmr, free_most_recent) {
+    ml::stack_pmr stack;
+    stack.reserve(1 << 10);
+
+    auto frame(stack.create_frame());
+    auto const size{stack.size()};
+
+    auto* ptr1{frame->allocate(64, 8)};
+    auto* ptr2{frame->allocate(64, 8)};
+
+    // Not the most recent so nothing is reclaimed
+    frame->deallocate(ptr1, 64, 8);
+    EXPECT_EQ(stack.size(), size + 128);
+
+    frame->deallocate(ptr2, 64, 8);
+    EXPECT_EQ(stack.size(), size + 64);
+    EXPECT_EQ(frame->allocate(64, 8), ptr2);
+}
+TEST(stack_pmr, extend_in_place) {
+    ml::stack_pmr stack;
+    stack.reserve(1 << 10);
+
+    auto frame(stack.create_frame());
+    auto const size{stack.size()};
+
+    auto* ptr{frame->allocate(16, 4)};
+    EXPECT_EQ(frame->extend(ptr, 16, 256, 4), ptr);
+    EXPECT_EQ(stack.size(), size + 256);
+
+    // Shrinking the top allocation gives the memory back
+    EXPECT_EQ(frame->extend(ptr, 256, 32, 4), ptr);
+    EXPECT_EQ(stack.size(), size + 32);
+}
+TEST(stack_pmr, extend_not_most_recent) {
+    ml::stack_pmr stack;
+    stack.reserve(1 << 10);
+
+    auto frame(stack.create_frame());
+    auto* ptr1{frame->allocate(16, 4)};
+    (void)frame->allocate(16, 4);
+
+    EXPECT_NE(frame->extend(ptr1, 16, 32, 4), ptr1);
+}
+TEST(stack_pmr, extend_past_segment) {
+    ml::stack_pmr stack;
+    stack.reserve(256);
+
+    auto frame(stack.create_frame());
+    auto* ptr{frame->allocate(16, 4)};
+
+    EXPECT_NE(frame->extend(ptr, 16, 1024, 4), ptr);
+    EXPECT_EQ(stack.n_segments(), 2);
+}
+TEST(stack_pmr, ml_pmr_interface) {
+    ml::stack_pmr stack;
+    stack.reserve(1 << 10);
+
+    auto frame(stack.create_frame());
+    ml::pmr& resource{*frame};
+
+    auto* ptr{resource.allocate(16, 4)};
+    EXPECT_EQ(resource.extend(ptr, 16, 64, 4), ptr);
+    EXPECT_TRUE(resource.is_equal(*frame));
+}
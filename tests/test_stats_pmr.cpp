@@ -0,0 +1,175 @@
+#include <cstddef>
+#include <memory_resource>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "containers/arena_pmr.hpp"
+#include "containers/new_delete_pmr.hpp"
+#include "containers/pmr.hpp"
+#include "containers/stats_pmr.hpp"
+
+#include "configure_warning_pragmas.hpp"
+
+TEST(stats_pmr, counts_allocations) {
+    ml::new_delete_pmr<ml::pmr> upstream;
+    ml::stats_pmr resource{&upstream};
+
+    auto* ptr1{resource.allocate(16, 8)};
+    auto* ptr2{resource.allocate(100, 4)};
+    resource.deallocate(ptr1, 16, 8);
+
+    auto const stats{resource.stats()};
+    EXPECT_EQ(stats.n_allocations, 2);
+    EXPECT_EQ(stats.n_deallocations, 1);
+    EXPECT_EQ(stats.live_bytes, 100);
+    EXPECT_EQ(stats.peak_bytes, 116);
+
+    resource.deallocate(ptr2, 100, 4);
+    EXPECT_EQ(resource.stats().live_bytes, 0);
+}
+TEST(stats_pmr, histograms) {
+    ml::new_delete_pmr<ml::pmr> upstream;
+    ml::stats_pmr resource{&upstream};
+
+    auto* ptr1{resource.allocate(16, 8)};
+    auto* ptr2{resource.allocate(20, 8)};
+    auto* ptr3{resource.allocate(1, 1)};
+
+    auto const stats{resource.stats()};
+    // 16..31 bytes
+    EXPECT_EQ(stats.size_histogram[5], 2);
+    EXPECT_EQ(stats.size_histogram[1], 1);
+    EXPECT_EQ(stats.alignment_histogram[3], 2);
+    EXPECT_EQ(stats.alignment_histogram[0], 1);
+
+    resource.deallocate(ptr1, 16, 8);
+    resource.deallocate(ptr2, 20, 8);
+    resource.deallocate(ptr3, 1, 1);
+}
+TEST(stats_pmr, extend_hits_and_fallbacks) {
+    ml::arena_pmr upstream;
+    ml::stats_pmr resource{static_cast<ml::pmr*>(&upstream)};
+
+    auto* ptr1{resource.allocate(16, 4)};
+    EXPECT_EQ(resource.extend(ptr1, 16, 32, 4), ptr1);
+
+    (void)resource.allocate(4, 4);
+    EXPECT_NE(resource.extend(ptr1, 32, 64, 4), ptr1);
+
+    auto const stats{resource.stats()};
+    EXPECT_EQ(stats.n_extends, 2);
+    EXPECT_EQ(stats.n_extends_in_place, 1);
+    EXPECT_EQ(stats.n_extends_fallback, 1);
+    EXPECT_DOUBLE_EQ(stats.extend_hit_rate(), 0.5);
+    EXPECT_EQ(stats.live_bytes, 32 + 4 + 64);
+}
+TEST(stats_pmr, extend_shrink_in_place_drops_live_bytes) {
+    ml::arena_pmr upstream;
+    ml::stats_pmr resource{static_cast<ml::pmr*>(&upstream)};
+
+    auto* ptr{resource.allocate(64, 4)};
+    EXPECT_EQ(resource.extend(ptr, 64, 16, 4), ptr);
+    EXPECT_EQ(resource.stats().live_bytes, 16);
+    EXPECT_EQ(resource.stats().peak_bytes, 64);
+
+    resource.deallocate(ptr, 16, 4);
+    EXPECT_EQ(resource.stats().live_bytes, 0);
+}
+TEST(stats_pmr, extend_of_null_is_an_allocation) {
+    ml::arena_pmr upstream;
+    ml::stats_pmr resource{static_cast<ml::pmr*>(&upstream)};
+
+    auto* ptr{resource.extend(nullptr, 0, 32, 4)};
+    EXPECT_EQ(resource.extend(ptr, 32, 64, 4), ptr);
+
+    auto const stats{resource.stats()};
+    EXPECT_EQ(stats.n_allocations, 1);
+    EXPECT_EQ(stats.n_extends, 1);
+    EXPECT_EQ(stats.n_extends_fallback, 0);
+    EXPECT_DOUBLE_EQ(stats.extend_hit_rate(), 1.0);
+    EXPECT_EQ(stats.live_bytes, 64);
+}
+TEST(stats_pmr, std_upstream_keeps_extend) {
+    ml::arena_pmr upstream;
+    ml::stats_pmr resource{static_cast<std::pmr::memory_resource*>(&upstream)};
+
+    auto* ptr1{resource.allocate(16, 4)};
+    EXPECT_EQ(resource.extend(ptr1, 16, 32, 4), ptr1);
+}
+TEST(stats_pmr, alignment_padding) {
+    ml::arena_pmr upstream{1024};
+    ml::stats_pmr resource{static_cast<ml::pmr*>(&upstream)};
+
+    (void)resource.allocate(1, 1);
+    (void)resource.allocate(8, 8);
+
+    EXPECT_EQ(resource.stats().padding_bytes, 7);
+}
+TEST(stats_pmr, std_pmr_vector) {
+    ml::arena_pmr upstream;
+    ml::stats_pmr resource{static_cast<ml::pmr*>(&upstream)};
+    std::pmr::vector<int> values{&resource};
+
+    for (int i{0}; i < 100; ++i) {
+        values.push_back(i);
+    }
+
+    auto const stats{resource.stats()};
+    EXPECT_GT(stats.n_allocations, 1);
+    EXPECT_EQ(stats.n_deallocations, stats.n_allocations - 1);
+    EXPECT_GE(stats.live_bytes, 100 * sizeof(int));
+}
+TEST(stats_pmr, reset_stats) {
+    ml::new_delete_pmr<ml::pmr> upstream;
+    ml::stats_pmr resource{&upstream};
+
+    auto* ptr{resource.allocate(16, 8)};
+    resource.reset_stats();
+
+    auto const stats{resource.stats()};
+    EXPECT_EQ(stats.n_allocations, 0);
+    EXPECT_EQ(stats.live_bytes, 16);
+    EXPECT_EQ(stats.peak_bytes, 16);
+    resource.deallocate(ptr, 16, 8);
+}
+TEST(stats_pmr, threads) {
+    constexpr int n_threads{4};
+    constexpr int n_allocations{1000};
+
+    ml::new_delete_pmr<ml::pmr> upstream;
+    ml::stats_pmr resource{&upstream};
+
+    {
+        std::vector<std::jthread> threads;
+        for (int t{0}; t < n_threads; ++t) {
+            threads.emplace_back([&] {
+                for (int i{0}; i < n_allocations; ++i) {
+                    auto* ptr{resource.allocate(32, 8)};
+                    resource.deallocate(ptr, 32, 8);
+                }
+            });
+        }
+    }
+
+    auto const stats{resource.stats()};
+    EXPECT_EQ(stats.n_allocations, n_threads * n_allocations);
+    EXPECT_EQ(stats.n_deallocations, n_threads * n_allocations);
+    EXPECT_EQ(stats.live_bytes, 0);
+}
+TEST(stats_pmr, single_thread_mode) {
+    ml::new_delete_pmr<ml::pmr> upstream;
+    ml::stats_pmr resource{&upstream, ml::stats_mode::single_thread};
+
+    auto* ptr1{resource.allocate(16, 8)};
+    auto* ptr2{resource.allocate(32, 8)};
+    resource.deallocate(ptr1, 16, 8);
+    resource.deallocate(ptr2, 32, 8);
+
+    auto const stats{resource.stats()};
+    EXPECT_EQ(stats.n_allocations, 2);
+    EXPECT_EQ(stats.n_deallocations, 2);
+    EXPECT_EQ(stats.live_bytes, 0);
+    EXPECT_EQ(stats.peak_bytes, 48);
+}
@@ -0,0 +1,153 @@
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "containers/dlist.hpp"
+#include "containers/pmr_allocator.hpp"
+#include "containers/stats_pmr.hpp"
+#include "containers/thread_cache_pmr.hpp"
+
+#include "configure_warning_pragmas.hpp"
+
+TEST(thread_cache_pmr, freed_block_is_reused) {
+    ml::thread_cache_pmr resource;
+
+    auto* ptr{resource.allocate(24, 8)};
+    resource.deallocate(ptr, 24, 8);
+    // Same size class, most recently freed block first
+    EXPECT_EQ(resource.allocate(32, 8), ptr);
+    resource.deallocate(ptr, 32, 8);
+}
+TEST(thread_cache_pmr, alignment) {
+    ml::thread_cache_pmr resource;
+
+    auto* ptr{resource.allocate(8, 64)};
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ptr) % 64, 0);
+    resource.deallocate(ptr, 8, 64);
+}
+TEST(thread_cache_pmr, refills_in_batches) {
+    ml::stats_pmr upstream{ml::get_new_delete_pmr<ml::pmr>()};
+    {
+        ml::thread_cache_pmr resource{&upstream, {.magazine_capacity = 16, .batch_size = 8, .shared_capacity = 64}};
+
+        auto* ptr{resource.allocate(16)};
+        EXPECT_EQ(upstream.stats().n_allocations, 8);
+        EXPECT_EQ(resource.n_thread_cached(16), 7);
+        resource.deallocate(ptr, 16);
+    }
+    // Everything goes back when the resource is destroyed
+    EXPECT_EQ(upstream.stats().live_bytes, 0);
+}
+TEST(thread_cache_pmr, surplus_goes_upstream) {
+    ml::stats_pmr upstream{ml::get_new_delete_pmr<ml::pmr>()};
+    ml::thread_cache_pmr resource{&upstream, {.magazine_capacity = 16, .batch_size = 8, .shared_capacity = 16}};
+
+    std::vector<void*> ptrs;
+    for (int i{0}; i < 100; ++i) {
+        ptrs.push_back(resource.allocate(16));
+    }
+    for (auto* ptr : ptrs) {
+        resource.deallocate(ptr, 16);
+    }
+
+    EXPECT_LE(resource.n_thread_cached(16), 16);
+    EXPECT_LE(resource.n_shared_cached(16), 16);
+    EXPECT_GT(upstream.stats().n_deallocations, 0);
+    EXPECT_EQ(upstream.stats().live_bytes,
+              (resource.n_thread_cached(16) + resource.n_shared_cached(16)) * std::size_t{16});
+}
+TEST(thread_cache_pmr, large_requests_bypass_cache) {
+    ml::stats_pmr upstream{ml::get_new_delete_pmr<ml::pmr>()};
+    ml::thread_cache_pmr resource{&upstream};
+
+    auto* ptr{resource.allocate(ml::thread_cache_pmr::max_cached_size + 1)};
+    EXPECT_EQ(upstream.stats().n_allocations, 1);
+    resource.deallocate(ptr, ml::thread_cache_pmr::max_cached_size + 1);
+    EXPECT_EQ(upstream.stats().live_bytes, 0);
+}
+TEST(thread_cache_pmr, extend_within_size_class) {
+    ml::thread_cache_pmr resource;
+
+    auto* ptr{resource.allocate(20, 8)};
+    EXPECT_EQ(resource.extend(ptr, 20, 32, 8), ptr);
+    auto* moved{resource.extend(ptr, 32, 64, 8)};
+    EXPECT_NE(moved, ptr);
+    resource.deallocate(ptr, 32, 8);
+    resource.deallocate(moved, 64, 8);
+}
+TEST(thread_cache_pmr, free_on_another_thread) {
+    ml::stats_pmr upstream{ml::get_new_delete_pmr<ml::pmr>()};
+    {
+        ml::thread_cache_pmr resource{&upstream};
+
+        std::vector<void*> ptrs;
+        for (int i{0}; i < 1000; ++i) {
+            ptrs.push_back(resource.allocate(48));
+        }
+        std::thread consumer{[&] {
+            for (auto* ptr : ptrs) {
+                resource.deallocate(ptr, 48);
+            }
+        }};
+        consumer.join();
+
+        // The consumer's magazines were flushed when it exited
+        EXPECT_EQ(resource.n_shared_cached(64) + resource.n_thread_cached(64),
+                  upstream.stats().n_allocations - upstream.stats().n_deallocations);
+    }
+    EXPECT_EQ(upstream.stats().live_bytes, 0);
+}
+TEST(thread_cache_pmr, many_threads_share_nodes) {
+    ml::stats_pmr upstream{ml::get_new_delete_pmr<ml::pmr>()};
+    {
+        ml::thread_cache_pmr resource{&upstream};
+        using list_type = ml::dlist<int, ml::pmr_allocator>;
+
+        std::vector<std::thread> threads;
+        for (int t{0}; t < 4; ++t) {
+            threads.emplace_back([&resource, t] {
+                list_type list{list_type::allocator_type{&resource}};
+                for (int i{0}; i < 10'000; ++i) {
+                    list.push_back(i + t);
+                    if (i % 3 == 0) {
+                        list.pop_front();
+                    }
+                }
+                // dlist doesn't free its nodes on destruction
+                list.clear();
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+    EXPECT_EQ(upstream.stats().live_bytes, 0);
+}
+TEST(thread_cache_pmr, destroyed_while_threads_rebind) {
+    ml::stats_pmr upstream{ml::get_new_delete_pmr<ml::pmr>()};
+    ml::thread_cache_pmr other{&upstream};
+
+    for (int round{0}; round < 20; ++round) {
+        auto resource{std::make_unique<ml::thread_cache_pmr>(&upstream)};
+        std::atomic<bool> bound{false};
+        std::atomic<bool> go{false};
+
+        std::thread worker{[&] {
+            resource->deallocate(resource->allocate(32), 32);
+            bound = true;
+            while (!go) {}
+            // Binding another instance drops the entries of destroyed ones while the destructor may still run
+            other.deallocate(other.allocate(32), 32);
+        }};
+        while (!bound) {}
+        go = true;
+        resource.reset();
+        worker.join();
+    }
+    EXPECT_EQ(upstream.stats().live_bytes, other.n_shared_cached(32) * std::size_t{32});
+}
@@ -1,7 +1,14 @@
 #include <algorithm>
 #include <cstddef>
+#include <list>
+#include <memory_resource>
 #include <numeric>
+#include <ranges>
+#include <sstream>
+#include <stdexcept>
+#include <string>
 #include <tuple>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -9,6 +16,8 @@
 #include "test_vector.hpp"
 #include "vector_container_traits.hpp"
 
+#include "containers/allocator.hpp"
+#include "containers/arena_pmr.hpp"
 #include "containers/vector.hpp"
 #include "containers/pmr_allocator.hpp"
 #include "containers/new_delete_pmr.hpp"
@@ -39,6 +48,256 @@ TEST(vector, reserve) {
     values.reserve(5);
     EXPECT_EQ(values.capacity(), 5);
 }
+TEST(vector, push_back_fills_capacity_before_growing) {
+    ml::vector<int> values;
+    values.reserve(4);
+    for (int i{0}; i < 4; ++i) {
+        values.push_back(i);
+    }
+    EXPECT_EQ(values.capacity(), 4);
+    values.push_back(4);
+    EXPECT_EQ(values.capacity(), 8);
+}
+TEST(vector, growth_policy_factor) {
+    ml::vector<int, std::allocator<int>, ml::vector_growth_1_5x> values;
+    std::vector<std::size_t> capacities;
+    for (int i{0}; i < 20; ++i) {
+        values.push_back(i);
+        if (capacities.empty() || capacities.back() != values.capacity()) {
+            capacities.push_back(values.capacity());
+        }
+    }
+    EXPECT_EQ(capacities, (std::vector<std::size_t>{1, 2, 3, 4, 6, 9, 13, 19, 28}));
+}
+TEST(vector, growth_policy_rounds_to_pages) {
+    constexpr ml::vector_growth_policy policy{.page_threshold = 4096, .page_size = 4096};
+    static_assert(policy.next_capacity(100, 101, 4) == 200);
+    static_assert(policy.next_capacity(1000, 1001, 4) == 2048);
+    static_assert(policy.next_capacity(1500, 1501, 4) == 3072);
+}
+TEST(vector, allocate_at_least_slack_becomes_capacity) {
+    ml::vector<char, ml::allocator<char>> values;
+    values.push_back('a');
+    EXPECT_EQ(values.capacity(), alignof(std::max_align_t));
+    for (auto i{1uz}; i < alignof(std::max_align_t); ++i) {
+        values.push_back('a');
+    }
+    EXPECT_EQ(values.capacity(), alignof(std::max_align_t));
+}
+TEST(vector, construct_from_iterators) {
+    std::list<std::string> const source{"a", "b", "c"};
+    ml::vector<std::string> values(source.begin(), source.end());
+    EXPECT_TRUE(std::ranges::equal(values, source));
+}
+TEST(vector, construct_from_initializer_list) {
+    ml::vector<int> values{1, 2, 3};
+    EXPECT_EQ(values.size(), 3);
+    EXPECT_EQ(values.back(), 3);
+}
+TEST(vector, append_range_allocates_once) {
+    std::vector<int> source(100);
+    std::iota(source.begin(), source.end(), 0);
+
+    ml::vector<int> values{-1};
+    values.append_range(source);
+    EXPECT_EQ(values.size(), 101);
+    EXPECT_EQ(values.capacity(), 101);
+    EXPECT_EQ(values[0], -1);
+    EXPECT_TRUE(std::ranges::equal(values | std::views::drop(1), source));
+}
+TEST(vector, append_range_input_range) {
+    std::istringstream stream{"1 2 3 4"};
+    ml::vector<int> values;
+    values.append_range(std::views::istream<int>(stream));
+    EXPECT_TRUE(std::ranges::equal(values, std::vector{1, 2, 3, 4}));
+}
+TEST(vector, insert_range_middle) {
+    ml::vector<int> values{0, 1, 5, 6};
+    values.reserve(10);
+    auto it{values.insert_range(values.begin() + 2, std::vector{2, 3, 4})};
+    EXPECT_EQ(it, values.begin() + 2);
+    EXPECT_TRUE(std::ranges::equal(values, std::views::iota(0, 7)));
+}
+TEST(vector, insert_range_reallocates) {
+    ml::vector<std::string> values{"a", "e"};
+    std::list<std::string> const source{"b", "c", "d"};
+    values.insert_range(values.begin() + 1, source);
+    EXPECT_TRUE(std::ranges::equal(values, std::vector<std::string>{"a", "b", "c", "d", "e"}));
+}
+TEST(vector, insert_range_non_trivial_in_place) {
+    ml::vector<std::string> values{"a", "d"};
+    values.reserve(8);
+    values.insert_range(values.begin() + 1, std::vector<std::string>{"b", "c"});
+    EXPECT_TRUE(std::ranges::equal(values, std::vector<std::string>{"a", "b", "c", "d"}));
+}
+TEST(vector, insert_range_input_range) {
+    std::istringstream stream{"1 2"};
+    ml::vector<int> values{0, 3};
+    values.insert_range(values.begin() + 1, std::views::istream<int>(stream));
+    EXPECT_TRUE(std::ranges::equal(values, std::views::iota(0, 4)));
+}
+TEST(vector, insert_range_throw_leaves_vector_unchanged) {
+    struct throws_on_copy {
+        int value;
+        throws_on_copy(int value)
+            : value{value} {}
+        throws_on_copy(throws_on_copy const& other)
+            : value{other.value} {
+            if (value < 0) {
+                throw std::runtime_error{"copy"};
+            }
+        }
+        throws_on_copy(throws_on_copy&&) noexcept = default;
+        auto operator=(throws_on_copy const&) -> throws_on_copy& = default;
+        auto operator=(throws_on_copy&&) noexcept -> throws_on_copy& = default;
+        ~throws_on_copy() {}
+    };
+    std::vector<throws_on_copy> source;
+    source.emplace_back(4);
+    source.emplace_back(-1);
+
+    ml::vector<throws_on_copy> values;
+    values.append_range(std::vector<throws_on_copy>{1, 2, 3});
+    values.reserve(10);
+    EXPECT_THROW(values.insert_range(values.begin() + 1, source), std::runtime_error);
+    EXPECT_EQ(values.size(), 3);
+    EXPECT_EQ(values[1].value, 2);
+    EXPECT_EQ(values[2].value, 3);
+
+    // Too many to fit so the new block is used
+    std::vector<throws_on_copy> large;
+    for (int i{0}; i < 20; ++i) {
+        large.emplace_back(-i);
+    }
+    EXPECT_THROW(values.insert_range(values.begin(), large), std::runtime_error);
+    EXPECT_EQ(values.size(), 3);
+    EXPECT_EQ(values[0].value, 1);
+}
+TEST(vector, insert_single) {
+    ml::vector<std::string> values{"a", "c"};
+    auto it{values.insert(values.begin() + 1, "b")};
+    EXPECT_EQ(*it, "b");
+    values.insert(values.end(), "d");
+    EXPECT_TRUE(std::ranges::equal(values, std::vector<std::string>{"a", "b", "c", "d"}));
+}
+TEST(vector, insert_own_element) {
+    ml::vector<std::string> values{"a", "b", "c"};
+    values.reserve(10);
+    values.insert(values.begin(), values[2]);
+    EXPECT_TRUE(std::ranges::equal(values, std::vector<std::string>{"c", "a", "b", "c"}));
+    values.shrink_to_fit();
+    values.insert(values.begin(), values[3]);
+    EXPECT_TRUE(std::ranges::equal(values, std::vector<std::string>{"c", "c", "a", "b", "c"}));
+}
+TEST(vector, insert_own_element_trivial) {
+    ml::vector<int> values{1, 2, 3};
+    values.reserve(10);
+    values.insert(values.begin(), values[2]);
+    EXPECT_TRUE(std::ranges::equal(values, std::vector{3, 1, 2, 3}));
+}
+TEST(vector, push_back_own_element) {
+    ml::vector<std::string> values{"a"};
+    for (int i{0}; i < 8; ++i) {
+        values.push_back(values[0]);
+    }
+    EXPECT_EQ(values.size(), 9);
+    EXPECT_TRUE(std::ranges::all_of(values, [](auto const& s) { return s == "a"; }));
+}
+TEST(vector, assign_range) {
+    ml::vector<std::string> values{"x", "y"};
+    values.assign_range(std::vector<std::string>{"a", "b", "c"});
+    EXPECT_TRUE(std::ranges::equal(values, std::vector<std::string>{"a", "b", "c"}));
+    values.assign_range(std::vector<std::string>{"d"});
+    EXPECT_TRUE(std::ranges::equal(values, std::vector<std::string>{"d"}));
+}
+TEST(vector, erase_range) {
+    ml::vector<int> values{0, 1, 2, 3, 4, 5};
+    auto it{values.erase(values.begin() + 1, values.begin() + 4)};
+    EXPECT_EQ(*it, 4);
+    EXPECT_TRUE(std::ranges::equal(values, std::vector{0, 4, 5}));
+    values.erase(values.begin());
+    EXPECT_TRUE(std::ranges::equal(values, std::vector{4, 5}));
+}
+TEST(vector, erase_range_non_trivial) {
+    ml::vector<std::string> values{"a", "b", "c", "d"};
+    auto it{values.erase(values.begin(), values.begin() + 2)};
+    EXPECT_EQ(*it, "c");
+    EXPECT_TRUE(std::ranges::equal(values, std::vector<std::string>{"c", "d"}));
+    values.erase(values.begin(), values.end());
+    EXPECT_TRUE(values.empty());
+}
+TEST(vector, resize) {
+    ml::vector<int> values{1, 2};
+    values.resize(4);
+    EXPECT_TRUE(std::ranges::equal(values, std::vector{1, 2, 0, 0}));
+    values.resize(6, 7);
+    EXPECT_TRUE(std::ranges::equal(values, std::vector{1, 2, 0, 0, 7, 7}));
+    values.resize(1);
+    EXPECT_TRUE(std::ranges::equal(values, std::vector{1}));
+}
+TEST(vector, resize_from_own_element) {
+    ml::vector<std::string> values{"a", "b"};
+    values.shrink_to_fit();
+    values.resize(5, values[0]);
+    EXPECT_TRUE(std::ranges::equal(values, std::vector<std::string>{"a", "b", "a", "a", "a"}));
+}
+TEST(vector, resize_for_overwrite) {
+    ml::vector<int> values;
+    values.resize_for_overwrite(50);
+    EXPECT_EQ(values.size(), 50);
+    EXPECT_EQ(values.capacity(), 50);
+    std::iota(values.begin(), values.end(), 0);
+    EXPECT_EQ(values[49], 49);
+}
+TEST(vector, shrink_to_fit_reallocates) {
+    ml::vector<std::string> values{"a", "b", "c"};
+    values.reserve(100);
+    values.shrink_to_fit();
+    EXPECT_EQ(values.capacity(), 3);
+    EXPECT_TRUE(std::ranges::equal(values, std::vector<std::string>{"a", "b", "c"}));
+
+    values.clear();
+    values.shrink_to_fit();
+    EXPECT_EQ(values.capacity(), 0);
+    EXPECT_EQ(values.data(), nullptr);
+}
+TEST(vector, shrink_to_fit_in_place) {
+    ml::arena_pmr resource;
+    ml::vector<int, ml::pmr_allocator<int>> values{&resource};
+    values.reserve(100);
+    values.append_range(std::vector{1, 2, 3});
+    auto const* data{values.data()};
+
+    values.shrink_to_fit();
+    EXPECT_EQ(values.capacity(), 3);
+    EXPECT_EQ(values.data(), data);
+    EXPECT_EQ(resource.arena().total_size(), 3 * sizeof(int));
+}
+TEST(vector, reserve_and_fill) {
+    ml::vector<char> values{'a'};
+    std::string const source{"bcdef"};
+    auto n{values.reserve_and_fill(8, [&](char* dest, std::size_t n) {
+        return source.copy(dest, n);
+    })};
+    EXPECT_EQ(n, 5);
+    EXPECT_EQ(values.size(), 6);
+    EXPECT_GE(values.capacity(), 9);
+    EXPECT_EQ(std::string(values.data(), values.size()), "abcdef");
+
+    values.reserve_and_fill(2, [](char* dest, std::size_t n) { std::fill_n(dest, n, 'x'); });
+    EXPECT_EQ(std::string(values.data(), values.size()), "abcdefxx");
+}
+TEST(vector, move_assign_polymorphic_allocator) {
+    std::pmr::monotonic_buffer_resource resource_a;
+    std::pmr::monotonic_buffer_resource resource_b;
+    using Vector = ml::vector<std::string, std::pmr::polymorphic_allocator<std::string>>;
+    Vector a(&resource_a);
+    Vector b(&resource_b);
+    b.push_back("x");
+    a = std::move(b);
+    EXPECT_EQ(a.size(), 1);
+    EXPECT_EQ(a[0], "x");
+}
 
 template <typename T, typename Allocator>
 struct ContainerTestTraits<ml::vector<T, Allocator>>
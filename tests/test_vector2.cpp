@@ -1,6 +1,9 @@
 #include <algorithm>
 #include <memory>
 #include <numeric>
+#include <ranges>
+#include <string>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -10,11 +13,16 @@
 
 #include "containers/arena_mmr.hpp"
 #include "containers/arena_mmr_allocator.hpp"
+#include "containers/arena_pmr.hpp"
 #include "containers/buffer_pmr.hpp"
+#include "containers/malloc_pmr.hpp"
 #include "containers/mmr_allocator.hpp"
+#include "containers/new_delete_pmr.hpp"
 #include "containers/pmr.hpp"
 #include "containers/pmr_allocator.hpp"
+#include "containers/stack_pmr.hpp"
 #include "containers/vector2.hpp"
+#include "containers/vm_arena_mmr.hpp"
 
 #include "configure_warning_pragmas.hpp"
 
@@ -131,6 +139,192 @@ TEST(vector2, smr_pop_back_empty) {
     EXPECT_THROW(values.pop_back(), std::out_of_range);
 }
 
+// Arena
+TEST(vector2, arena_pmr_grows_in_place) {
+    ml::arena_pmr resource{1 << 16};
+    intvec values{&resource};
+
+    values.emplace_back(0);
+    auto const* data{values.data()};
+
+    for (int i{1}; i < 1000; ++i) {
+        values.emplace_back(i);
+    }
+
+    EXPECT_EQ(values.data(), data);
+    EXPECT_EQ(values.back(), 999);
+}
+
+// Stack frames
+TEST(vector2, stack_frame_grows_in_place) {
+    ml::stack_pmr stack;
+    stack.reserve(1 << 12);
+
+    auto frame(stack.create_frame());
+    auto const size{stack.size()};
+    {
+        intvec values{frame.get()};
+        for (int i{0}; i < 100; ++i) {
+            values.emplace_back(i);
+        }
+
+        // Only the final buffer is left on the stack
+        EXPECT_EQ(stack.size(), size + values.capacity() * sizeof(int));
+    }
+    // The destructor frees the top-most allocation
+    EXPECT_EQ(stack.size(), size);
+}
+
+// Virtual memory arena
+TEST(vector2, vm_arena_grows_in_place) {
+    ml::vm_arena_options options;
+    options.reserve_bytes = std::size_t{64} << 20;
+    ml::vm_arena_mmr resource{options};
+    ml::mmr_allocator<int, ml::vm_arena_mmr> alloc{&resource};
+    ml::vector2<int, ml::mmr_allocator<int, ml::vm_arena_mmr>> values{alloc};
+
+    values.emplace_back(0);
+    auto const* data{values.data()};
+
+    constexpr int n_elems{100'000};
+    for (int i{1}; i < n_elems; ++i) {
+        values.emplace_back(i);
+    }
+
+    EXPECT_EQ(values.data(), data);
+    EXPECT_EQ(values.size(), n_elems);
+    EXPECT_EQ(values.back(), n_elems - 1);
+}
+
+// malloc
+TEST(vector2, malloc_pmr_keeps_elements_across_reallocation) {
+    // Small threshold so the buffer is remapped after a few grows
+    ml::malloc_pmr resource{4096};
+    intvec values{&resource};
+
+    constexpr int n_elems{100'000};
+    for (int i{0}; i < n_elems; ++i) {
+        values.emplace_back(i);
+    }
+
+    ASSERT_EQ(values.size(), n_elems);
+    for (int i{0}; i < n_elems; ++i) {
+        ASSERT_EQ(values[i], i);
+    }
+}
+
+// Bulk operations
+TEST(vector2, reserve) {
+    ml::arena_pmr resource;
+    intvec values{&resource};
+    values.reserve(50);
+    EXPECT_EQ(values.capacity(), 50);
+    EXPECT_EQ(resource.arena().total_size(), 50 * sizeof(int));
+}
+TEST(vector2, append_range_extends_once_in_place) {
+    ml::arena_pmr resource{1 << 16};
+    intvec values{&resource};
+    values.emplace_back(0);
+    auto const* data{values.data()};
+
+    std::vector<int> source(999);
+    std::iota(source.begin(), source.end(), 1);
+    values.append_range(source);
+
+    // One extend to the exact final size, in place
+    EXPECT_EQ(values.data(), data);
+    EXPECT_EQ(values.capacity(), 1000);
+    EXPECT_EQ(resource.arena().total_size(), 1000 * sizeof(int));
+    EXPECT_TRUE(std::ranges::equal(values, std::views::iota(0, 1000)));
+}
+TEST(vector2, smr_append_range_extends_in_place) {
+    stack_pmr<int, 100> resource;
+    intvec values{&resource};
+    values.emplace_back(0);
+    auto const* data{values.data()};
+
+    values.append_range(std::vector{1, 2, 3, 4});
+    EXPECT_EQ(values.data(), data);
+    EXPECT_EQ(values.size(), 5);
+}
+TEST(vector2, insert_erase_trivial) {
+    intvec values{ml::get_new_delete_pmr()};
+    values.append_range(std::vector{0, 4, 5});
+    values.insert_range(values.begin() + 1, std::vector{1, 2});
+    auto it{values.insert(values.begin() + 3, 3)};
+    EXPECT_EQ(*it, 3);
+    EXPECT_TRUE(std::ranges::equal(values, std::views::iota(0, 6)));
+
+    it = values.erase(values.begin() + 1, values.begin() + 3);
+    EXPECT_EQ(*it, 3);
+    values.erase(values.begin());
+    EXPECT_TRUE(std::ranges::equal(values, std::vector{3, 4, 5}));
+}
+TEST(vector2, insert_erase_non_trivial) {
+    vec_pmr<std::string> values{ml::get_new_delete_pmr()};
+    values.append_range(std::vector<std::string>{"a", "d"});
+    values.insert_range(values.begin() + 1, std::vector<std::string>{"b", "c"});
+    values.insert(values.end(), "e");
+    EXPECT_TRUE(std::ranges::equal(values, std::vector<std::string>{"a", "b", "c", "d", "e"}));
+
+    values.erase(values.begin(), values.begin() + 2);
+    EXPECT_TRUE(std::ranges::equal(values, std::vector<std::string>{"c", "d", "e"}));
+}
+TEST(vector2, insert_own_element) {
+    vec_pmr<std::string> values{ml::get_new_delete_pmr()};
+    values.append_range(std::vector<std::string>{"a", "b", "c"});
+    values.shrink_to_fit();
+    values.insert(values.begin(), values[2]);
+    EXPECT_TRUE(std::ranges::equal(values, std::vector<std::string>{"c", "a", "b", "c"}));
+    values.reserve(10);
+    values.insert(values.begin(), values[3]);
+    EXPECT_TRUE(std::ranges::equal(values, std::vector<std::string>{"c", "c", "a", "b", "c"}));
+}
+TEST(vector2, push_back_and_resize_from_own_element) {
+    vec_pmr<std::string> values{ml::get_new_delete_pmr()};
+    values.push_back("a");
+    for (int i{0}; i < 4; ++i) {
+        values.push_back(values[0]);
+    }
+    values.shrink_to_fit();
+    values.resize(8, values[0]);
+    EXPECT_EQ(values.size(), 8);
+    EXPECT_TRUE(std::ranges::all_of(values, [](auto const& s) { return s == "a"; }));
+}
+TEST(vector2, resize) {
+    intvec values{ml::get_new_delete_pmr()};
+    values.resize(3);
+    EXPECT_TRUE(std::ranges::equal(values, std::vector{0, 0, 0}));
+    values.resize(5, 7);
+    EXPECT_TRUE(std::ranges::equal(values, std::vector{0, 0, 0, 7, 7}));
+    values.resize(1);
+    EXPECT_EQ(values.size(), 1);
+}
+TEST(vector2, shrink_to_fit_returns_tail_to_arena) {
+    ml::arena_pmr resource;
+    intvec values{&resource};
+    values.reserve(100);
+    values.append_range(std::vector{1, 2, 3});
+    auto const* data{values.data()};
+
+    values.shrink_to_fit();
+    EXPECT_EQ(values.data(), data);
+    EXPECT_EQ(values.capacity(), 3);
+    EXPECT_EQ(resource.arena().total_size(), 3 * sizeof(int));
+}
+TEST(vector2, smr_shrink_to_fit_returns_tail) {
+    stack_pmr<int, 100> resource;
+    intvec values{&resource};
+    values.reserve(50);
+    values.append_range(std::vector{1, 2});
+    values.shrink_to_fit();
+    EXPECT_EQ(values.capacity(), 2);
+
+    // The freed tail is used by the next extend
+    values.append_range(std::vector<int>(90, 0));
+    EXPECT_EQ(values.size(), 92);
+}
+
 template <typename T, typename Allocator>
 struct ContainerTestTraits<ml::vector2<T, Allocator>>
     : vector_container_traits<ml::vector2<T, Allocator>> {
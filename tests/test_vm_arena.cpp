@@ -0,0 +1,142 @@
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "containers/mmr_allocator.hpp"
+#include "containers/vm_arena_mmr.hpp"
+
+#include "configure_warning_pragmas.hpp"
+
+static constexpr std::size_t reserve_bytes{std::size_t{64} << 20};
+
+static auto small_arena() -> ml::vm_arena_mmr {
+    ml::vm_arena_options options;
+    options.reserve_bytes = reserve_bytes;
+    return ml::vm_arena_mmr{options};
+}
+
+TEST(vm_arena, reserve_without_commit) {
+    auto resource{small_arena()};
+    EXPECT_NE(resource.data(), nullptr);
+    EXPECT_EQ(resource.reserved(), reserve_bytes);
+    EXPECT_EQ(resource.committed(), 0);
+    EXPECT_EQ(resource.size(), 0);
+}
+TEST(vm_arena, allocate_commits_pages) {
+    auto resource{small_arena()};
+
+    auto* ptr{static_cast<std::byte*>(resource.allocate(100, alignof(std::byte)))};
+    ASSERT_NE(ptr, nullptr);
+    ptr[99] = std::byte{1};
+
+    EXPECT_EQ(resource.size(), 100);
+    EXPECT_GE(resource.committed(), 100);
+    EXPECT_EQ(resource.committed() % resource.options().commit_granularity, 0);
+}
+TEST(vm_arena, allocate_with_alignment) {
+    auto resource{small_arena()};
+
+    constexpr std::size_t alignment{64};
+    (void)resource.allocate(3, 1);
+    auto* ptr{resource.allocate(128, alignment)};
+
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ptr) % alignment, 0);
+}
+TEST(vm_arena, allocate_past_reservation) {
+    auto resource{small_arena()};
+    EXPECT_THROW((void)resource.allocate(reserve_bytes + 1, 1), std::bad_alloc);
+}
+TEST(vm_arena, extend_in_place_across_commits) {
+    auto resource{small_arena()};
+    ml::mmr_allocator<int, ml::vm_arena_mmr> alloc{&resource};
+
+    std::size_t n_elems{1};
+    auto* ptr{alloc.allocate(n_elems)};
+    ptr[0] = 0;
+
+    // Grow well past the commit granularity
+    while (n_elems < (std::size_t{1} << 20)) {
+        auto* extended{alloc.extend(ptr, n_elems, n_elems * 2)};
+        ASSERT_EQ(extended, ptr);
+        for (auto i{n_elems}; i < n_elems * 2; ++i) {
+            ptr[i] = static_cast<int>(i);
+        }
+        n_elems *= 2;
+    }
+
+    EXPECT_EQ(resource.size(), n_elems * sizeof(int));
+    EXPECT_EQ(ptr[n_elems - 1], static_cast<int>(n_elems - 1));
+}
+TEST(vm_arena, extend_after_other_allocation) {
+    auto resource{small_arena()};
+
+    auto* ptr1{resource.allocate(16, 8)};
+    (void)resource.allocate(16, 8);
+    auto* ptr2{resource.extend(ptr1, 16, 32, 8)};
+
+    EXPECT_NE(ptr1, ptr2);
+}
+TEST(vm_arena, reset_releases_pages) {
+    auto resource{small_arena()};
+
+    auto* ptr{static_cast<int*>(resource.allocate(sizeof(int), alignof(int)))};
+    *ptr = 42;
+
+    resource.reset();
+    EXPECT_EQ(resource.size(), 0);
+
+    auto* ptr2{static_cast<int*>(resource.allocate(sizeof(int), alignof(int)))};
+    EXPECT_EQ(ptr, ptr2);
+    // The page was handed back to the OS so it comes back zeroed
+    EXPECT_EQ(*ptr2, 0);
+}
+TEST(vm_arena, mark_and_rewind) {
+    auto resource{small_arena()};
+
+    (void)resource.allocate(64, 8);
+    auto const m{resource.mark()};
+    auto* ptr{resource.allocate(64, 8)};
+
+    resource.rewind(m);
+    EXPECT_EQ(resource.size(), 64);
+    EXPECT_EQ(resource.allocate(64, 8), ptr);
+}
+TEST(vm_arena, populate_and_huge_pages) {
+    ml::vm_arena_options options;
+    options.reserve_bytes = reserve_bytes;
+    options.page_mode = ml::vm_page_mode::transparent_huge;
+    options.populate = true;
+    ml::vm_arena_mmr resource{options};
+
+    auto* ptr{static_cast<std::byte*>(resource.allocate(1 << 22, 64))};
+    ptr[(1 << 22) - 1] = std::byte{1};
+    EXPECT_EQ(resource.committed() % (std::size_t{2} << 20), 0);
+    // The madvised ranges must cover whole huge pages
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(resource.data()) % (std::size_t{2} << 20), 0);
+}
+TEST(vm_arena, move) {
+    auto resource{small_arena()};
+    auto* ptr{resource.allocate(16, 8)};
+
+    ml::vm_arena_mmr moved{std::move(resource)};
+    EXPECT_EQ(moved.size(), 16);
+    EXPECT_EQ(moved.data(), ptr);
+    EXPECT_EQ(resource.data(), nullptr);
+}
+
+// Vector usage
+TEST(vm_arena, std_vector_large) {
+    auto resource{small_arena()};
+    ml::mmr_allocator<int, ml::vm_arena_mmr> alloc{&resource};
+    std::vector<int, ml::mmr_allocator<int, ml::vm_arena_mmr>> vec{alloc};
+
+    constexpr int n_elems{100'000};
+    for (int i{0}; i < n_elems; ++i) {
+        vec.push_back(i);
+    }
+
+    EXPECT_EQ(vec.size(), n_elems);
+    EXPECT_EQ(vec.back(), n_elems - 1);
+}